@@ -7,6 +7,11 @@
 #include "grafo.h"
 #include "solucao.h"
 #include "utils.h"
+#include "busca_tabu.h"
+#include "checkpoint.h"
+#include "trace.h"
+
+class PoolSubarvores;
 
 /**
  * Estrutura para representar um candidato (aresta) na construção gulosa
@@ -26,6 +31,56 @@ struct Candidato {
     }
 };
 
+/**
+ * Conjunto de alterações na instância para re-otimização incremental
+ * (consultas "e se": preço de um enlace, demanda de um ponto, novo terminal)
+ */
+struct EdicaoInstancia {
+    struct AlteracaoCusto {
+        int origem;
+        int destino;
+        double custo;
+    };
+    struct AlteracaoDemanda {
+        int vertice;
+        int demanda;
+    };
+    struct NovoTerminal {
+        std::vector<double> custos;  // Custo para cada vértice existente
+        int demanda;
+    };
+
+    std::vector<AlteracaoCusto> custos;        // Aplicadas nos dois sentidos
+    std::vector<AlteracaoDemanda> demandas;
+    std::vector<NovoTerminal> novosTerminais;
+
+    /**
+     * Aplica as alterações ao grafo (novos terminais recebem os próximos IDs).
+     * Os IDs não são conferidos aqui: alterações montadas fora de carregar
+     * devem usar vértices existentes, ou serão ignoradas pelo grafo
+     */
+    void aplicar(Grafo& grafo) const;
+
+    /**
+     * Lê alterações de um arquivo texto, uma por linha:
+     *   custo <i> <j> <valor>
+     *   demanda <v> <valor>
+     *   terminal <demanda> <custo para 0> <custo para 1> ... <custo para n-1>
+     * Linhas vazias ou iniciadas por '#' são ignoradas
+     * @param numVertices Vértices da instância: IDs fora de 0..numVertices-1,
+     *        laços, demandas negativas e terminais com mais custos que vértices
+     *        existentes são recusados com o número da linha
+     * @return true se todas as linhas foram lidas e são válidas
+     */
+    bool carregar(const std::string& nomeArquivo, int numVertices);
+
+    /**
+     * Traduz os IDs do arquivo de alterações (numeração da instância) para a
+     * numeração interna do grafo, caso ele tenha sido renumerado
+     */
+    EdicaoInstancia paraIdsInternos(const Grafo& grafo) const;
+};
+
 /**
  * Classe que implementa os algoritmos heurísticos para CMST
  */
@@ -40,6 +95,27 @@ private:
     mutable int proximoSubId;  // Next available subtree ID
     mutable bool cacheValido;  // Cache validity flag
 
+    std::vector<int> paisIniciais;  // Solução de partida (warm start); vazio se não houver
+    std::string construtor;         // Motor construtivo: "prim" (padrão) ou "kruskal"
+    const ControleExecucao* controle;  // Cancelamento e progresso (opcional)
+    std::string politicaAlpha;      // Seleção de alpha do reativo: "roleta" (padrão), "ucb1" ou "thompson"
+    double larguraAlpha;            // > 0: alpha de cada braço sorteado em alphas[i] ± largura/2
+    bool abandono;                  // Abandona construções que não podem superar a incumbente
+    bool usarTrocaCiclica;          // Troca cíclica entre subárvores no pós-processamento
+    int intervaloRecombinacao;      // Iterações entre recombinações do pool de subárvores (0 = desativada)
+    RegistroTrace* trace;           // Trace de convergência por iteração (opcional)
+
+    // Checkpoint da busca reativa
+    std::string arquivoCheckpoint;  // Vazio = desativado
+    int intervaloCheckpoint;        // Iterações entre checkpoints
+    bool retomarCheckpoint;         // Retoma do checkpoint existente, se houver
+    bool checkpointRecusado;        // O checkpoint existente não pôde ser retomado (execução não feita)
+
+    /**
+     * Retorna se o controle externo pediu o cancelamento da execução
+     */
+    bool cancelado() const;
+
     /**
      * Calcula a demanda atual de uma subárvore na solução parcial
      * @param solucao Solução parcial
@@ -102,9 +178,135 @@ private:
     /**
      * Constrói solução usando abordagem gulosa randomizada
      * @param alpha Parâmetro de aleatoriedade [0, 1]
+     * @param limiteAbandono Abandona a construção assim que o custo parcial mais um
+     *                       limite inferior do custo de conclusão ultrapassar este
+     *                       valor (INFINITO = nunca abandona)
+     * @param limiteInferior Se não nulo, recebe o limite inferior do custo final que
+     *                       provocou o abandono, ou -1 se a construção foi concluída
+     * @return Solução construída (parcial, se abandonada)
+     */
+    Solucao construirGulosoRandomizado(double alpha, double limiteAbandono = INFINITO,
+                                       double* limiteInferior = nullptr) const;
+
+    /**
+     * Custo da aresta mais barata que sai do vértice (0 se não houver nenhuma)
+     */
+    double menorAresta(int vertice) const;
+
+    /**
+     * Construção Kruskal capacitada (estilo Esau-Williams): percorre a lista de
+     * arestas pré-ordenada do grafo unindo componentes com union-find, que guarda
+     * a demanda de cada componente e se ele já está ligado à raiz. A variante
+     * randomizada sorteia entre as próximas 1 + alpha*(n-1) arestas viáveis;
+     * arestas inviáveis são descartadas de vez (a inviabilidade é monotônica).
+     * Limite inferior para o abandono: uniões feitas mais, para cada componente, o
+     * menor entre a sua ligação à raiz e a próxima aresta ativa.
+     * @param alpha Parâmetro de aleatoriedade [0, 1] (0 = Kruskal puro)
+     * @param limiteAbandono Ver construirGulosoRandomizado
+     * @param limiteInferior Ver construirGulosoRandomizado
      * @return Solução construída
      */
-    Solucao construirGulosoRandomizado(double alpha) const;
+    Solucao construirKruskal(double alpha, double limiteAbandono = INFINITO,
+                             double* limiteInferior = nullptr) const;
+
+    /**
+     * Completa uma solução parcial usando a inserção gulosa randomizada
+     * @param parcial Solução parcial (vértices conectados devem alcançar a raiz)
+     * Limite inferior para o abandono: custo parcial mais a aresta mais barata de
+     * cada vértice ainda desconectado.
+     * @param alpha Parâmetro de aleatoriedade [0, 1]
+     * @param limiteAbandono Ver construirGulosoRandomizado
+     * @param limiteInferior Ver construirGulosoRandomizado
+     * @return Solução completa
+     */
+    Solucao completarGulosoRandomizado(const Solucao& parcial, double alpha,
+                                       double limiteAbandono = INFINITO,
+                                       double* limiteInferior = nullptr) const;
+
+    /**
+     * Ruína do LNS: desconecta uma subárvore inteira, um agrupamento de
+     * vértices próximos ou um subconjunto aleatório (estratégia sorteada),
+     * junto com todos os seus descendentes
+     * @param solucao Solução completa
+     * @param numRemover Número aproximado de vértices a remover
+     * @return Solução parcial
+     */
+    Solucao destruirParcialmente(const Solucao& solucao, int numRemover) const;
+
+    /**
+     * Desconecta os vértices marcados e todos os seus descendentes
+     * @param solucao Solução de origem
+     * @param remover remover[v] = true para os vértices a desconectar
+     * @return Solução parcial (floresta presa à raiz)
+     */
+    Solucao desconectar(const Solucao& solucao, const std::vector<bool>& remover) const;
+
+    /**
+     * Laço de ruína e reconstrução do LNS a partir de uma solução
+     * @param iteracoesExecutadas Recebe o número de iterações realizadas
+     * @param somaCustos Acumula o custo das soluções candidatas
+     * @return Melhor solução encontrada
+     */
+    Solucao buscaLNS(const Solucao& inicial, double alpha, int numIteracoes, int numRemover,
+                     int& iteracoesExecutadas, double& somaCustos, bool verbose) const;
+
+    /**
+     * Sorteia o índice de um alpha pela roleta das probabilidades
+     */
+    int sortearAlpha(const std::vector<double>& probabilidades) const;
+
+    /**
+     * Escolhe o braço (índice de alpha) da próxima iteração do reativo segundo a
+     * política: roleta sobre as probabilidades, maior limite superior de
+     * confiança (ucb1) ou maior amostra da distribuição Beta a posteriori (thompson)
+     */
+    int escolherBraco(const EstadoReativo& estado) const;
+
+    /**
+     * Valor de alpha usado por um braço (sorteado na faixa do braço, se contínua)
+     */
+    double alphaDoBraco(const std::vector<double>& alphas, int braco) const;
+
+    /**
+     * Registra a recompensa de uma iteração nas estatísticas do braço (ucb1 e
+     * thompson): posição do custo entre o pior e o melhor custo já vistos, em
+     * [0, 1], com 1 para uma nova melhor solução e 0 para uma inviável
+     */
+    void registrarRecompensa(EstadoReativo& estado, int braco, double custo, bool valida) const;
+
+    /**
+     * Recalcula as probabilidades do reativo ao fim de um bloco a partir da
+     * qualidade de cada alpha (melhor custo global / melhor custo do alpha)
+     * @param estado Estado da busca (probabilidades atualizadas in-place)
+     * @param iter Iteração atual (apenas para o modo verboso)
+     */
+    void atualizarProbabilidades(const std::vector<double>& alphas, EstadoReativo& estado,
+                                 int iter, bool verbose) const;
+
+    /**
+     * Pós-processamento comum às três entradas executar*: recalcula a MST
+     * de cada subárvore da solução e atualiza seu custo
+     * @param solucao Solução a ser melhorada (modificada in-place)
+     * @param verbose Imprime o ganho obtido
+     */
+    void posProcessar(Solucao& solucao, bool verbose) const;
+
+    /**
+     * Recombina o pool de subárvores, se ele recebeu colunas desde a última
+     * recombinação, e substitui a incumbente pela partição se ela for melhor
+     * @param pool Pool do randomizado ou do reativo
+     * @param incumbente Melhor solução (substituída se houver melhora)
+     * @param custoIncumbente Custo da incumbente (INFINITO se nenhuma)
+     * @return true se a incumbente melhorou
+     */
+    bool recombinarPool(PoolSubarvores& pool, Solucao& incumbente, double& custoIncumbente, bool verbose) const;
+
+    /**
+     * Monta a solução de partida (warm start), se houver
+     * @param solucao Recebe a solução de partida
+     * @return true se existe solução de partida viável
+     */
+    bool obterSolucaoInicial(Solucao& solucao) const;
 
 public:
     /**
@@ -118,6 +320,125 @@ public:
      */
     ~Algoritmos();
 
+    /**
+     * Define uma solução de partida (warm start): semeia a incumbente dos
+     * algoritmos construtivos e o ponto de partida do LNS e da busca tabu
+     * @param pais Vetor de pais (vazio para remover)
+     */
+    void setSolucaoInicial(const std::vector<int>& pais);
+
+    /**
+     * Escolhe o motor construtivo usado por todos os algoritmos
+     * @param nome "prim" (inserção gulosa) ou "kruskal" (union-find capacitado)
+     * @return false se o nome for desconhecido
+     */
+    bool setConstrutor(const std::string& nome);
+
+    /**
+     * Define o controle externo das execuções: token de cancelamento consultado a
+     * cada iteração e callback de progresso (nulo para nenhum). Uma execução
+     * cancelada devolve a melhor solução encontrada até o momento.
+     * @param c Controle (deve permanecer válido durante as execuções)
+     */
+    void setControle(const ControleExecucao* c);
+
+    /**
+     * Escolhe a política de seleção de alpha do reativo
+     * @param nome "roleta" (probabilidades recalculadas a cada bloco), "ucb1" ou
+     *             "thompson" (bandidos atualizados a cada iteração)
+     * @param largura Largura da faixa de cada braço: o alpha é sorteado
+     *                uniformemente em alphas[i] ± largura/2 (0 = valores discretos)
+     * @return false se o nome for desconhecido
+     */
+    bool setPoliticaAlpha(const std::string& nome, double largura = 0);
+
+    /**
+     * Liga ou desliga o abandono antecipado de construções (randomizado e reativo):
+     * a construção para assim que o custo parcial mais um limite inferior do custo
+     * de conclusão mostrar que ela não pode superar a incumbente. Desligado por padrão.
+     */
+    void setAbandono(bool ativo);
+
+    /**
+     * Liga ou desliga a troca cíclica (trocaCiclica) no pós-processamento de todos
+     * os algoritmos. Desligada por padrão.
+     */
+    void setTrocaCiclica(bool ativa);
+
+    /**
+     * Liga a recombinação de subárvores no randomizado e no reativo: as subárvores
+     * de todas as construções (inclusive as abandonadas) vão para um pool
+     * (PoolSubarvores) e, a cada intervalo de iterações e ao final, um
+     * particionamento de conjuntos sobre o pool monta uma solução candidata a
+     * incumbente. O resultado da fase vai para tamanhoPool, recombinacoes,
+     * melhoriasRecombinacao e tempoRecombinacao de ResultadoExecucao.
+     * @param intervalo Iterações entre recombinações (0 = desativada, o padrão)
+     */
+    void setRecombinacao(int intervalo);
+
+    /**
+     * Define o trace binário de convergência: o randomizado e o reativo registram
+     * cada iteração (alpha, custo, viabilidade, abandono e incumbente)
+     * @param t Trace aberto (nulo para nenhum; deve permanecer válido durante as execuções)
+     */
+    void setTrace(RegistroTrace* t);
+
+    /**
+     * Configura checkpoints periódicos da busca reativa
+     * @param arquivo Arquivo do checkpoint (vazio desativa)
+     * @param intervalo Número de iterações entre gravações
+     * @param retomar Se true, continua a partir do checkpoint existente
+     */
+    void configurarCheckpoint(const std::string& arquivo, int intervalo, bool retomar);
+
+    /**
+     * Retorna se a última execução do reativo foi recusada porque, com retomada
+     * pedida, o checkpoint existente não corresponde aos parâmetros (ou está
+     * corrompido); o arquivo é preservado em vez de sobrescrito
+     */
+    bool isCheckpointRecusado() const;
+
+    /**
+     * Calcula a árvore geradora mínima de um subconjunto de vértices mais a raiz
+     * usando Prim O(k²) sobre a submatriz induzida
+     * @param vertices Vértices do subconjunto (sem a raiz)
+     * @param pais Se não nulo, recebe o pai de cada vértice (mesma ordem de vertices)
+     * @return Custo da árvore (INFINITO se o subconjunto não for conexo à raiz)
+     */
+    double arvoreMinimaSubconjunto(const std::vector<int>& vertices, std::vector<int>* pais = nullptr) const;
+
+    /**
+     * Re-otimiza cada subárvore da raiz: mantém o conjunto de vértices de cada
+     * subárvore e troca suas arestas internas pela MST exata (Prim em paralelo)
+     * @param solucao Solução completa (modificada in-place)
+     * @return Redução de custo obtida (>= 0)
+     */
+    double otimizarSubarvoresMST(Solucao& solucao) const;
+
+    /**
+     * Vizinhança de troca cíclica (Ahuja, Orlin e Sharma): monta o grafo de melhoria
+     * entre as subárvores da raiz, em que o arco x -> y move o vértice x (sozinho ou
+     * com seus descendentes) para a subárvore de y, de onde y sai, com custo igual à
+     * variação da MST da subárvore de y. Ciclos e caminhos de custo negativo que não
+     * repetem subárvores são procurados por correção de rótulos a partir de cada nó,
+     * e o melhor é aplicado até não haver melhora. O grafo de melhoria e a busca são
+     * calculados em paralelo.
+     * @param solucao Solução completa e viável (modificada in-place)
+     * @return Redução de custo obtida pelas trocas (>= 0), sem a re-otimização MST
+     *         das subárvores feita antes delas
+     */
+    double trocaCiclica(Solucao& solucao) const;
+
+    /**
+     * Adapta uma solução obtida com outra capacidade à capacidade atual do grafo:
+     * subárvores acima de Q são podadas (o excedente é reinserido de forma gulosa)
+     * e pares de subárvores que cabem juntas em Q são fundidos pela economia de
+     * Esau-Williams; ao final as subárvores são re-otimizadas pela MST
+     * @param anterior Solução completa para a capacidade anterior
+     * @return Solução completa para a capacidade atual
+     */
+    Solucao adaptarCapacidade(const Solucao& anterior) const;
+
     /**
      * Executa o algoritmo guloso
      * @param resultado Estrutura para armazenar resultados
@@ -145,6 +466,64 @@ public:
     Solucao executarGulosoReativo(const std::vector<double>& alphas,
                                    int numIteracoes, int tamanhoBloco,
                                    ResultadoExecucao& resultado, bool verbose = false);
+
+    /**
+     * Executa o reativo em modelo de ilhas: cada ilha (thread) roda seu próprio
+     * reativo, com distribuição de alphas e semente próprias, sobre uma parte das
+     * iterações. A cada intervaloMigracao iterações a ilha envia à vizinha no anel
+     * sua elite e sua distribuição de alphas por uma fila sem travas; a elite
+     * recebida é incorporada e a distribuição recebida é misturada à local a cada
+     * atualização de bloco. A resposta é o melhor membro das elites após o
+     * pós-processamento. Com mais de uma ilha, o resultado depende do momento das
+     * migrações e não é reprodutível pela semente.
+     * @param alphas Vetor de valores de alpha
+     * @param numIteracoes Número total de iterações (somando todas as ilhas)
+     * @param tamanhoBloco Tamanho do bloco para atualização de probabilidades
+     * @param numIlhas Número de ilhas
+     * @param intervaloMigracao Iterações de cada ilha entre migrações (<= 0 = tamanhoBloco)
+     * @param resultado Estrutura para armazenar resultados
+     * @return Melhor solução encontrada
+     */
+    Solucao executarGulosoReativoIlhas(const std::vector<double>& alphas, int numIteracoes,
+                                        int tamanhoBloco, int numIlhas, int intervaloMigracao,
+                                        ResultadoExecucao& resultado, bool verbose = false);
+
+    /**
+     * Executa a busca em vizinhança ampla (LNS) por ruína e reconstrução
+     * @param alpha Parâmetro de aleatoriedade da reinserção [0, 1]
+     * @param numIteracoes Número de iterações de ruína e reconstrução
+     * @param fracaoRemocao Fração dos vértices removida a cada iteração
+     * @param resultado Estrutura para armazenar resultados
+     * @return Melhor solução encontrada
+     */
+    Solucao executarLNS(double alpha, int numIteracoes, double fracaoRemocao,
+                        ResultadoExecucao& resultado, bool verbose = false);
+
+    /**
+     * Executa a busca tabu sobre religação de vértices/subárvores,
+     * partindo da solução gulosa
+     * @param numIteracoes Número máximo de iterações
+     * @param tempoLimite Limite de tempo em segundos (<= 0 para ilimitado)
+     * @param resultado Estrutura para armazenar resultados
+     * @return Melhor solução encontrada
+     */
+    Solucao executarBuscaTabu(int numIteracoes, double tempoLimite,
+                              ResultadoExecucao& resultado, bool verbose = false);
+
+    /**
+     * Re-otimização incremental após alterações na instância.
+     * As alterações já devem ter sido aplicadas ao grafo (EdicaoInstancia::aplicar);
+     * a solução anterior é usada para manter intacto tudo o que não foi afetado.
+     * Desconecta apenas os vértices/subárvores afetados, reinsere com o construtivo
+     * guloso e refina com algumas iterações de LNS.
+     * @param anterior Solução para a instância antes das alterações
+     * @param edicoes Alterações aplicadas
+     * @param iteracoesLNS Iterações de refinamento por LNS
+     * @param resultado Estrutura para armazenar resultados
+     * @return Nova solução viável para a instância alterada
+     */
+    Solucao reotimizar(const Solucao& anterior, const EdicaoInstancia& edicoes, int iteracoesLNS,
+                       ResultadoExecucao& resultado, bool verbose = false);
 };
 
 #endif // ALGORITMOS_H
@@ -0,0 +1,121 @@
+#ifndef BUSCA_TABU_H
+#define BUSCA_TABU_H
+
+#include <vector>
+#include <unordered_map>
+#include "grafo.h"
+#include "solucao.h"
+#include "utils.h"
+
+/**
+ * Movimento de religação: o vértice (com toda a sua subárvore) passa a ter novoPai
+ */
+struct MovimentoTabu {
+    int vertice;        // Vértice movido (leva seus descendentes junto)
+    int novoPai;        // Novo pai do vértice
+    double deltaCusto;  // Variação do custo das arestas
+    int deltaExcesso;   // Variação do excesso total de capacidade
+
+    MovimentoTabu(int v = -1, int p = -1, double dc = 0, int de = 0)
+        : vertice(v), novoPai(p), deltaCusto(dc), deltaExcesso(de) {}
+};
+
+/**
+ * Busca tabu sobre movimentos de religação de vértices/subárvores
+ *
+ * - Lista tabu por atributo: após mover v de u, religar v a u é proibido
+ *   durante o mandato (tenure)
+ * - Critério de aspiração por custo: movimento tabu é aceito se gerar uma
+ *   solução viável melhor que a melhor conhecida
+ * - Capacidade tratada por penalidade adaptativa sobre o excesso, permitindo
+ *   atravessar regiões inviáveis
+ * - Avaliação incremental O(1) por movimento, com cache das melhores
+ *   jogadas de cada vértice invalidado apenas nas subárvores afetadas
+ */
+class BuscaTabu {
+private:
+    const Grafo* grafo;
+    int n;
+    int raiz;
+    int capacidade;
+
+    // Estado corrente (pode ser inviável)
+    std::vector<int> pai;
+    double custoAtual;
+    int excessoAtual;
+
+    // Estruturas derivadas, recalculadas em O(n) após cada movimento
+    std::vector<int> primeiroFilho;     // Lista ligada de filhos
+    std::vector<int> proximoIrmao;
+    std::vector<int> entrada;           // Índice na pré-ordem
+    std::vector<int> tamanho;           // Número de vértices na subárvore de v
+    std::vector<int> demandaDesc;       // Demanda da subárvore de v (inclusive)
+    std::vector<int> raizSub;           // Filho da raiz que identifica a subárvore de v
+    std::vector<int> ordem;             // Vértices em pré-ordem
+
+    // Vizinhança restrita: k vizinhos mais próximos (a raiz é sempre avaliada)
+    std::vector<std::vector<int>> candidatos;
+    std::vector<std::vector<int>> reversos;   // reversos[p] = vértices que têm p como candidato
+
+    // Cache das melhores jogadas de cada vértice
+    std::vector<std::vector<MovimentoTabu>> cacheMovimentos;
+    std::vector<char> cacheValido;
+
+    // Memória tabu: chave (v, u) -> última iteração em que o atributo é tabu
+    std::unordered_map<long long, int> tabu;
+
+    double penalidade;
+
+    const ControleExecucao* controle;   // Cancelamento e progresso (opcional)
+
+    /**
+     * Recalcula pré-ordem, demandas e subárvores da raiz a partir de pai
+     */
+    void recalcularEstruturas();
+
+    /**
+     * Avalia um movimento em O(1)
+     * @return false se o movimento for inválido (ciclo, aresta inexistente)
+     */
+    bool avaliar(int v, int p, MovimentoTabu& mov) const;
+
+    /**
+     * Recalcula a lista das melhores jogadas de um vértice
+     */
+    void atualizarCache(int v);
+
+    /**
+     * Excesso de capacidade de uma subárvore com a demanda informada
+     */
+    int excesso(int demanda) const;
+
+    bool ehTabu(int v, int p, int iter) const;
+
+    double avaliacao(const MovimentoTabu& mov) const;
+
+public:
+    /**
+     * Construtor
+     * @param g Ponteiro para o grafo
+     */
+    BuscaTabu(const Grafo* g);
+
+    /**
+     * Define o controle externo (cancelamento e progresso); nulo para nenhum
+     */
+    void setControle(const ControleExecucao* c);
+
+    /**
+     * Executa a busca a partir de uma solução completa
+     * @param inicial Solução inicial (completa; pode ser inviável)
+     * @param maxIteracoes Limite de iterações
+     * @param tempoLimite Limite de tempo em segundos (<= 0 para ilimitado)
+     * @param iteracoesExecutadas Recebe o número de iterações realizadas
+     * @param verbose Imprime o progresso
+     * @return Melhor solução viável encontrada (ou a inicial)
+     */
+    Solucao executar(const Solucao& inicial, int maxIteracoes, double tempoLimite,
+                     int& iteracoesExecutadas, bool verbose = false);
+};
+
+#endif // BUSCA_TABU_H
@@ -0,0 +1,61 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <vector>
+#include "grafo.h"
+
+/**
+ * Estado completo da busca reativa entre duas iterações.
+ * Junto com o estado do gerador aleatório, é suficiente para retomar a
+ * execução de forma bit a bit idêntica a uma execução sem interrupção.
+ */
+struct EstadoReativo {
+    std::vector<double> probabilidades;   // Probabilidade de cada alpha
+    std::vector<double> somaQualidade;    // Estatísticas por alpha (ucb1/thompson: soma das recompensas)
+    std::vector<int> contadorUso;
+    std::vector<double> melhorPorAlpha;
+    int proximaIteracao;                  // Primeira iteração ainda não executada
+    double somaCustos;
+    double melhorCustoGlobal;
+    double piorCusto;                     // Pior custo viável visto (0 se nenhum), normaliza a recompensa
+    int melhorAlphaIdx;
+    int abandonadas;                      // Construções abandonadas pelo limite inferior
+    std::vector<int> paisMelhor;          // Vetor de pais da incumbente (vazio se não houver)
+    double tempoDecorrido;                // Tempo acumulado até o checkpoint (segundos)
+
+    EstadoReativo(int numAlphas = 0);
+};
+
+/**
+ * Gravação e leitura de checkpoints da busca reativa
+ *
+ * O arquivo é texto, com os valores reais em hexadecimal (exatos), e é
+ * gravado de forma atômica (arquivo temporário + fsync + rename): uma
+ * interrupção durante a gravação preserva o checkpoint anterior.
+ * Os parâmetros da execução (instância, Q, alphas, iterações, bloco, política
+ * de seleção de alpha, abandono, construtor) são gravados junto e conferidos
+ * na leitura. Arquivos de versões anteriores não guardam o construtor e são
+ * recusados, pois não há como saber se foram gravados com prim ou kruskal.
+ */
+namespace Checkpoint {
+    /**
+     * Grava o estado da busca e do gerador aleatório
+     * @return true se gravou com sucesso
+     */
+    bool salvar(const std::string& arquivo, const Grafo& grafo,
+                const std::vector<double>& alphas, int numIteracoes, int tamanhoBloco,
+                const std::string& politica, double largura, bool abandono,
+                const std::string& construtor, const EstadoReativo& estado);
+
+    /**
+     * Lê o estado e restaura o gerador aleatório
+     * @return true se o arquivo existe e corresponde aos parâmetros informados
+     */
+    bool carregar(const std::string& arquivo, const Grafo& grafo,
+                  const std::vector<double>& alphas, int numIteracoes, int tamanhoBloco,
+                  const std::string& politica, double largura, bool abandono,
+                  const std::string& construtor, EstadoReativo& estado);
+}
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,129 @@
+#ifndef CMST_H
+#define CMST_H
+
+#include <string>
+#include <vector>
+#include "grafo.h"
+#include "solucao.h"
+#include "algoritmos.h"
+#include "utils.h"
+
+/**
+ * API da biblioteca libcmst
+ *
+ * Uso típico, sem arquivos nem saída no terminal:
+ *   Grafo grafo;
+ *   grafo.carregarMatriz(n, Q, custos, demandas);   // ou carregarInstanciaTexto
+ *   ParametrosExecucao p;
+ *   p.algoritmo = "lns";
+ *   ControleExecucao controle;                      // cancelar() de outra thread
+ *   controle.setCallbackProgresso(funcao, 50);
+ *   Solucao solucao(&grafo);
+ *   ResultadoExecucao resultado;
+ *   std::string erro;
+ *   CMST::resolver(grafo, p, solucao, resultado, &controle, &erro);
+ *
+ * O gerador aleatório é por thread: execuções simultâneas em threads diferentes
+ * são independentes e reprodutíveis pela semente de cada uma.
+ */
+
+/**
+ * Algoritmo e parâmetros de uma execução
+ */
+struct ParametrosExecucao {
+    std::string algoritmo = "guloso";  // guloso, randomizado, reativo, lns ou tabu
+    std::string construtor = "prim";   // Motor construtivo: prim ou kruskal
+
+    // Parâmetros do randomizado e do LNS (-1 = padrão do algoritmo: 0.3, ou 0.02 no LNS)
+    double alpha = -1;
+
+    // Número de iterações (-1 = padrão do algoritmo: 30, 300, 500, 5000 ou 20)
+    int numIteracoes = -1;
+
+    // Randomizado e reativo: abandona construções que não podem superar a incumbente
+    bool abandono = false;
+
+    // Pós-processamento de todos os algoritmos: troca cíclica entre subárvores
+    bool trocaCiclica = false;
+
+    // Randomizado e reativo: iterações entre recombinações do pool de subárvores (0 = desativada)
+    int intervaloRecombinacao = 0;
+
+    // Parâmetros do reativo
+    std::vector<double> alphas = {0.1, 0.3, 0.5};
+    int tamanhoBloco = 30;
+
+    // Seleção de alpha do reativo: roleta (por bloco), ucb1 ou thompson (a cada iteração)
+    std::string politicaAlpha = "roleta";
+
+    // Faixa contínua de alpha (usada se alphaMax > alphaMin): dividida em numBracos
+    // braços de mesma largura, com o alpha sorteado dentro do braço; substitui alphas
+    double alphaMin = 0;
+    double alphaMax = 0;
+    int numBracos = 8;
+
+    // Reativo em ilhas (numIlhas > 1): iterações de cada ilha entre migrações (0 = tamanhoBloco)
+    int numIlhas = 1;
+    int intervaloMigracao = 0;
+
+    // Checkpoint do reativo
+    std::string arquivoCheckpoint;
+    int intervaloCheckpoint = 50;
+    bool retomar = false;
+
+    // Trace binário de convergência do randomizado e do reativo (vazio = desativado)
+    std::string arquivoTrace;
+
+    // Parâmetros do LNS
+    double fracaoRemocao = 0.1;
+
+    // Parâmetros da re-otimização
+    std::string arquivoEdicoes;
+
+    // Parâmetros da busca tabu
+    double tempoLimite = 10;
+
+    // Semente do gerador (usada se usarSemente; senão o estado atual do gerador é mantido)
+    bool usarSemente = false;
+    unsigned int semente = 0;
+
+    // Solução de partida na numeração interna do grafo (vazio = nenhuma)
+    std::vector<int> paisIniciais;
+
+    /**
+     * Retorna uma cópia com os valores -1 trocados pelos padrões do algoritmo e
+     * com a faixa contínua de alpha, se houver, convertida nos centros dos braços
+     */
+    ParametrosExecucao comPadroes() const;
+};
+
+namespace CMST {
+    /**
+     * Executa um dos algoritmos de solução (todos exceto 'reotimizar') com um
+     * Algoritmos já configurado (construtor, solução inicial, controle)
+     * @param erro Recebe a mensagem em caso de falha (pode ser nulo)
+     * @return false se o algoritmo for desconhecido ou se o checkpoint a retomar
+     *         não corresponder aos parâmetros (o arquivo é preservado)
+     */
+    bool executarAlgoritmo(Algoritmos& alg, const ParametrosExecucao& p, ResultadoExecucao& resultado,
+                           Solucao& melhorSolucao, bool verbose = false, std::string* erro = nullptr);
+
+    /**
+     * Resolve a instância: configura o construtor, a solução de partida e o
+     * controle, inicializa a semente (se pedida) e executa o algoritmo
+     * @param grafo Instância (os índices são preparados na primeira chamada)
+     * @param p Algoritmo e parâmetros (valores -1 recebem os padrões)
+     * @param solucao Recebe a melhor solução encontrada
+     * @param resultado Recebe custo, tempo e parâmetros efetivos da execução
+     * @param controle Cancelamento e progresso (nulo para nenhum)
+     * @param erro Recebe a mensagem se os parâmetros forem inválidos (pode ser nulo)
+     * @param verbose Imprime o andamento no terminal
+     * @return false se o algoritmo ou o construtor for desconhecido, ou se o
+     *         checkpoint a retomar não corresponder aos parâmetros
+     */
+    bool resolver(const Grafo& grafo, const ParametrosExecucao& p, Solucao& solucao,
+                  ResultadoExecucao& resultado, const ControleExecucao* controle = nullptr,
+                  std::string* erro = nullptr, bool verbose = false);
+}
+
+#endif // CMST_H
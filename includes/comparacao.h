@@ -0,0 +1,84 @@
+#ifndef COMPARACAO_H
+#define COMPARACAO_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Execução lida de um CSV de resultados (EscritorCSV)
+ */
+struct ExecucaoCSV {
+    std::string instancia;
+    std::string algoritmo;
+    std::map<std::string, std::string> configuracao;  // Colunas de configuração presentes no arquivo (Q, alpha, opções...)
+    std::string semente;
+    double tempoSegundos;
+    double custo;
+};
+
+/**
+ * Comparação pareada de uma instância com um algoritmo e parâmetros (diferenças = B - A)
+ */
+struct GrupoComparacao {
+    std::string instancia;
+    std::string algoritmo;
+    std::string parametros;     // Configuração não vazia, como "Q=3 iter=100 construtor=prim"
+    int numPares;
+    double custoA;              // Medianas
+    double custoB;
+    double deltaCusto;          // Mediana das diferenças de custo por par
+    double valorPCusto;         // Wilcoxon bilateral
+    double tempoA;
+    double tempoB;
+    double deltaTempo;          // Mediana da variação relativa de tempo por par (0.1 = +10%)
+    double valorPTempo;
+    bool regressaoCusto;        // B significativamente mais caro
+    bool regressaoTempo;        // B significativamente mais lento, além da tolerância
+    bool melhoraCusto;
+    bool melhoraTempo;
+};
+
+/**
+ * Opções da comparação (cmst compare)
+ */
+struct OpcoesComparacao {
+    double nivel = 0.05;             // Nível de significância dos testes
+    double toleranciaTempo = 0.05;   // Variação relativa de tempo abaixo da qual não há regressão
+};
+
+/**
+ * Resultado da comparação de dois arquivos
+ */
+struct ResultadoComparacao {
+    std::vector<GrupoComparacao> grupos;  // Em ordem de instância, algoritmo e parâmetros
+    int semParA;                          // Execuções de A sem correspondente em B
+    int semParB;
+    int regressoes;                       // Grupos com regressão de custo ou de tempo
+};
+
+/**
+ * Comparação A/B de arquivos de resultados: as execuções são pareadas por
+ * (instância, algoritmo, configuração, semente) e, dentro de cada instância com
+ * o mesmo algoritmo e configuração, as diferenças de custo e de tempo passam
+ * pelo teste dos postos sinalizados de Wilcoxon. A configuração reúne Q, alpha,
+ * iterações, bloco, construtor, política de alpha e opções; uma coluna ausente
+ * em um dos arquivos (CSV de versão anterior) fica fora da chave. Execuções
+ * repetidas com a mesma chave são pareadas na ordem em que aparecem.
+ */
+namespace Comparacao {
+    /**
+     * Lê um CSV de resultados pelas colunas do cabeçalho (instancia, algoritmo,
+     * semente, tempo_segundos e melhor_solucao são obrigatórias)
+     * @param erro Recebe a mensagem se o arquivo não puder ser lido
+     */
+    bool lerCSV(const std::string& arquivo, std::vector<ExecucaoCSV>& execucoes, std::string& erro);
+
+    /**
+     * Pareia as execuções e testa cada grupo
+     */
+    ResultadoComparacao comparar(const std::vector<ExecucaoCSV>& a, const std::vector<ExecucaoCSV>& b,
+                                 const OpcoesComparacao& opcoes);
+}
+
+#endif // COMPARACAO_H
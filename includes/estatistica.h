@@ -0,0 +1,81 @@
+#ifndef ESTATISTICA_H
+#define ESTATISTICA_H
+
+#include <vector>
+
+/**
+ * Testes estatísticos não paramétricos usados na comparação de configurações
+ */
+namespace Estatistica {
+    /**
+     * Postos de uma amostra (1 = menor valor), com a média dos postos nos empates
+     */
+    std::vector<double> postos(const std::vector<double>& valores);
+
+    /**
+     * Função de distribuição da qui-quadrado com gl graus de liberdade
+     */
+    double distribuicaoQuiQuadrado(double x, int gl);
+
+    /**
+     * Função de distribuição da t de Student com gl graus de liberdade
+     */
+    double distribuicaoT(double x, int gl);
+
+    /**
+     * Quantil da t de Student (inversa de distribuicaoT, por bisseção)
+     * @param p Probabilidade acumulada em (0, 1)
+     */
+    double quantilT(double p, int gl);
+
+    /**
+     * Função de distribuição da normal padrão
+     */
+    double distribuicaoNormal(double x);
+
+    /**
+     * Mediana de uma amostra (média dos dois centrais se o tamanho for par; NAN se vazia)
+     */
+    double mediana(std::vector<double> valores);
+
+    /**
+     * Resultado do teste dos postos sinalizados de Wilcoxon
+     */
+    struct ResultadoWilcoxon {
+        int numPares;          // Diferenças não nulas usadas no teste
+        double somaPositivos;  // W+: soma dos postos das diferenças positivas
+        double valorP;         // Bilateral
+        bool exato;            // Distribuição exata (senão, aproximação normal)
+    };
+
+    /**
+     * Teste dos postos sinalizados de Wilcoxon sobre diferenças pareadas
+     * (H0: mediana das diferenças = 0). Diferenças nulas são descartadas e os
+     * empates em |d| recebem o posto médio. Até 50 pares o valor p vem da
+     * distribuição exata de W+ condicionada aos postos; acima, da aproximação
+     * normal com correção de empates e de continuidade. Sem pares, valorP = 1.
+     * @param diferencas d_i = b_i - a_i
+     */
+    ResultadoWilcoxon wilcoxon(const std::vector<double>& diferencas);
+
+    /**
+     * Resultado do teste de Friedman sobre uma matriz blocos × tratamentos
+     */
+    struct ResultadoFriedman {
+        std::vector<double> somaPostos;  // Soma dos postos de cada tratamento nos blocos
+        double estatistica;              // T de Friedman (corrigida para empates)
+        double valorP;                   // P(qui-quadrado com k-1 gl >= T)
+        double diferencaCritica;         // Diferença mínima entre somas de postos (Conover)
+    };
+
+    /**
+     * Teste de Friedman com comparações múltiplas de Conover, como na F-race:
+     * dois tratamentos diferem se as somas de postos diferem mais que a diferença
+     * crítica. Sem variação nos postos (todos empatados), valorP = 1.
+     * @param blocos blocos[b][t] = medida do tratamento t no bloco b (menor = melhor)
+     * @param nivel Nível de significância das comparações (ex.: 0.05)
+     */
+    ResultadoFriedman friedman(const std::vector<std::vector<double>>& blocos, double nivel);
+}
+
+#endif // ESTATISTICA_H
@@ -0,0 +1,67 @@
+#ifndef FILA_SPSC_H
+#define FILA_SPSC_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Fila circular sem travas com um único produtor e um único consumidor
+ *
+ * Os índices de início (consumidor) e fim (produtor) só crescem; a posição no
+ * buffer é o índice módulo a capacidade. Cada lado escreve apenas o seu índice
+ * e lê o do outro com acquire, de modo que o item gravado antes do release do
+ * produtor fica visível ao consumidor. Os dois índices ficam em linhas de cache
+ * separadas para não disputarem a mesma linha.
+ */
+template <typename T>
+class FilaSPSC {
+private:
+    std::vector<T> itens;
+    size_t capacidade;
+    alignas(64) std::atomic<size_t> inicio;  // Próximo item a ler (escrito pelo consumidor)
+    alignas(64) std::atomic<size_t> fim;     // Próxima posição livre (escrita pelo produtor)
+
+public:
+    /**
+     * Construtor
+     * @param capacidadeMaxima Número máximo de itens na fila (mínimo 1)
+     */
+    explicit FilaSPSC(size_t capacidadeMaxima)
+        : itens(capacidadeMaxima > 0 ? capacidadeMaxima : 1),
+          capacidade(capacidadeMaxima > 0 ? capacidadeMaxima : 1), inicio(0), fim(0) {}
+
+    FilaSPSC(const FilaSPSC&) = delete;
+    FilaSPSC& operator=(const FilaSPSC&) = delete;
+
+    /**
+     * Insere um item (apenas a thread produtora)
+     * @return false se a fila estiver cheia (o item não é consumido)
+     */
+    bool enviar(T&& item) {
+        size_t f = fim.load(std::memory_order_relaxed);
+        if (f - inicio.load(std::memory_order_acquire) == capacidade) {
+            return false;
+        }
+        itens[f % capacidade] = std::move(item);
+        fim.store(f + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Retira o item mais antigo (apenas a thread consumidora)
+     * @return false se a fila estiver vazia
+     */
+    bool receber(T& item) {
+        size_t i = inicio.load(std::memory_order_relaxed);
+        if (i == fim.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = std::move(itens[i % capacidade]);
+        inicio.store(i + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif // FILA_SPSC_H
@@ -8,23 +8,184 @@
 #include <sstream>
 #include <limits>
 #include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <new>
 
 #define INFINITO std::numeric_limits<double>::infinity()
 
+/**
+ * Alocador com alinhamento de linha de cache, usado no armazenamento dos custos
+ */
+template <typename T, std::size_t Alinhamento = 64>
+struct AlocadorAlinhado {
+    typedef T value_type;
+
+    AlocadorAlinhado() = default;
+    template <typename U>
+    AlocadorAlinhado(const AlocadorAlinhado<U, Alinhamento>&) {}
+
+    template <typename U>
+    struct rebind {
+        typedef AlocadorAlinhado<U, Alinhamento> other;
+    };
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alinhamento)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(Alinhamento));
+    }
+
+    bool operator==(const AlocadorAlinhado&) const { return true; }
+    bool operator!=(const AlocadorAlinhado&) const { return false; }
+};
+
+/**
+ * Aresta não direcionada (origem < destino) com seu custo
+ */
+struct Aresta {
+    int origem;
+    int destino;
+    double custo;
+};
+
+/**
+ * Vizinhos de um vértice na adjacência CSR, em ordem de ID, com os custos
+ * das arestas (vertices[k] tem custo custos[k])
+ */
+struct Vizinhanca {
+    const int* vertices;
+    const double* custos;
+    int grau;
+};
+
 /**
  * Classe Grafo para o problema CMST (Capacitated Minimum Spanning Tree)
- * Armazena grafo completo com matriz de adjacência
+ * Instâncias em matriz (OR-Library) são armazenadas como grafo completo com a
+ * matriz de custos: triangular inferior compactada quando a instância é
+ * simétrica, completa caso contrário. Instâncias em lista de arestas são
+ * armazenadas esparsas, em adjacência CSR com memória O(n + m).
  */
 class Grafo {
 private:
     int numVertices;                              // Número de vértices
     int capacidade;                               // Capacidade máxima das subárvores (Q)
     int raiz;                                     // Vértice raiz (default = 0)
-    std::vector<std::vector<double>> matrizAdj;  // Matriz de adjacência (custos)
+    
+    // Custos. Instância simétrica: triangular inferior compactada, linha i guarda
+    // c(i, 0..i). Assimétrica: matriz completa. Cada linha começa em fronteira de
+    // 64 bytes (inicioLinha[i] múltiplo de 8), para varreduras vetorizáveis
+    std::vector<double, AlocadorAlinhado<double>> custos;
+    std::vector<size_t> inicioLinha;
+    bool simetrica;
+
+    // Instância esparsa (lista de arestas): a matriz fica vazia e c(v, u) está em
+    // custosCSR[k], com vizinhosCSR[k] = u, para k em [inicioCSR[v], inicioCSR[v + 1]);
+    // cada linha em ordem crescente de u (busca binária em getCusto e existeAresta)
+    bool esparsa;
+    std::vector<int> inicioCSR;
+    std::vector<int> vizinhosCSR;
+    std::vector<double> custosCSR;
+
     std::vector<int> demandas;                    // Demanda de cada vértice (default = 1)
     double solucaoOtima;                          // Solução ótima conhecida (se disponível)
     std::string nomeInstancia;                    // Nome do arquivo de instância
 
+    // Índice independente de Q: vizinhos de cada vértice ordenados por custo
+    mutable std::vector<std::vector<int>> vizinhosOrdenados;
+    mutable bool vizinhosValidos;
+
+    // Índice independente de Q: lista de arestas ordenada por custo (construção Kruskal)
+    mutable std::vector<Aresta> arestasOrdenadas;
+
+    // Índice independente de Q, só na instância esparsa: adjacência das arestas
+    // existentes (respeitando a poda), em ordem de ID, para as varreduras O(grau)
+    // dos algoritmos; na matriz elas leem as linhas com copiarLinha
+    mutable std::vector<int> inicioAdjacencia;
+    mutable std::vector<int> adjacentes;
+    mutable std::vector<double> custosAdjacentes;
+
+    // Renumeração interna: idOriginal[v] = ID do vértice v no arquivo (vazio = identidade)
+    std::vector<int> idOriginal;
+    std::vector<int> idInterno;
+
+    // Poda de arestas: bit ligado se (i, j) não precisa ser considerada (existe
+    // solução ótima sem ela); respeitada por existeAresta. Um bit por posição de
+    // custos, endereçado por posicao() (na triangular, um só para os dois
+    // sentidos); na instância esparsa, pela posição da aresta em vizinhosCSR
+    std::vector<bool> arestaEliminada;
+    bool podaAtiva;
+    int numArestasEliminadas;
+    int numArestasTotal;
+
+    /**
+     * Recalcula a máscara de arestas eliminadas, se a poda estiver ativa
+     * (chamado pelos setters); invalida os índices se a máscara mudar
+     */
+    void atualizarPoda();
+
+    /**
+     * Invalida os índices derivados da matriz (chamado pelos setters)
+     */
+    void invalidarIndices();
+
+    /**
+     * Posição de c(origem, destino) em custos (índices já validados)
+     */
+    size_t posicao(int origem, int destino) const {
+        if (simetrica && destino > origem) {
+            return inicioLinha[destino] + origem;
+        }
+        return inicioLinha[origem] + destino;
+    }
+
+    /**
+     * Posição de c(origem, destino) em custosCSR, ou -1 se a aresta não existe
+     */
+    int posicaoCSR(int origem, int destino) const;
+
+    /**
+     * Define c(origem, destino) na instância esparsa, inserindo a aresta se não existir
+     */
+    void definirCustoCSR(int origem, int destino, double custo);
+
+    /**
+     * Monta a adjacência CSR esparsa a partir das listas (vizinho, custo) de cada
+     * vértice; arestas repetidas ficam com o menor custo
+     */
+    void montarCSR(std::vector<std::vector<std::pair<int, double>>>& listas);
+
+    /**
+     * Volta ao armazenamento em matriz (descarta a adjacência esparsa)
+     */
+    void descartarCSR();
+
+    /**
+     * Monta o armazenamento a partir de uma matriz completa n×n (linha a linha),
+     * compactando-a se for simétrica
+     */
+    void montarArmazenamento(const std::vector<double>& completa);
+
+    /**
+     * Passa do armazenamento compactado para o completo (custo assimétrico)
+     */
+    void expandirParaCompleta();
+
+    /**
+     * Lê a instância no formato OR-Library de um fluxo
+     * @param entrada Fluxo com o conteúdo da instância
+     * @param nome Nome da instância
+     */
+    bool lerInstancia(std::istream& entrada, const std::string& nome);
+
+    /**
+     * Lê a instância no formato de lista de arestas (após a palavra ARESTAS)
+     * @param entrada Fluxo posicionado logo após ARESTAS
+     * @param nome Nome da instância
+     */
+    bool lerListaArestas(std::istream& entrada, const std::string& nome);
+
 public:
     /**
      * Construtor padrão
@@ -46,14 +207,42 @@ public:
     /**
      * Carrega instância de arquivo no formato OR-Library
      * Formato:
-     *   Linha 1: n Q (número de vértices e capacidade)
-     *   Linhas seguintes: Matriz de distâncias n×n
+     *   Linha 1: n Q (número de terminais e capacidade)
+     *   Linhas seguintes: Matriz de distâncias (n+1)×(n+1), raiz na posição 0
+     *   (também aceita n×n, com a raiz entre os n vértices)
      *   Última linha (opcional): Valor da solução ótima
+     * ou no formato de lista de arestas (grafo esparso):
+     *   ARESTAS n Q        n terminais (vértices 1..n) e a raiz 0
+     *   u v custo          uma aresta não direcionada por linha
+     *   DEMANDA v d        (opcional) demanda do vértice v, padrão 1
+     *   OTIMO valor        (opcional) solução ótima conhecida
+     *   Linhas iniciadas por # são ignoradas; vértices sem aresta não têm ligação
      * @param nomeArquivo Caminho do arquivo
      * @return true se carregou com sucesso
      */
     bool carregarInstancia(const std::string& nomeArquivo);
 
+    /**
+     * Carrega instância de um texto em memória, no mesmo formato do arquivo
+     * @param conteudo Conteúdo completo da instância
+     * @param nome Nome da instância (usado nos resultados)
+     * @return true se carregou com sucesso
+     */
+    bool carregarInstanciaTexto(const std::string& conteudo, const std::string& nome);
+
+    /**
+     * Carrega instância de uma matriz de custos em memória
+     * @param n Número de vértices (incluindo a raiz)
+     * @param cap Capacidade máxima das subárvores
+     * @param matriz Custos n×n em ordem de linhas (c(i,j) = matriz[i * n + j])
+     * @param demandasVertices Demanda de cada vértice (nulo = unitária)
+     * @param raizInstancia Vértice raiz
+     * @param nome Nome da instância (usado nos resultados)
+     * @return true se carregou com sucesso
+     */
+    bool carregarMatriz(int n, int cap, const double* matriz, const int* demandasVertices = nullptr,
+                        int raizInstancia = 0, const std::string& nome = "memoria");
+
     // Getters
     int getNumVertices() const;
     int getCapacidade() const;
@@ -62,13 +251,129 @@ public:
     double getCusto(int origem, int destino) const;
     double getSolucaoOtima() const;
     std::string getNomeInstancia() const;
-    const std::vector<std::vector<double>>& getMatrizAdj() const;
+
+    /**
+     * Retorna se a matriz de custos é simétrica (armazenada compactada)
+     */
+    bool isSimetrica() const;
+
+    /**
+     * Retorna se a instância é esparsa (lista de arestas, adjacência CSR)
+     */
+    bool isEsparsa() const;
+
+    /**
+     * Copia a linha de custos c(vertice, 0..n-1) para um buffer contíguo
+     * (trecho compactado copiado em bloco; o restante lido pela coluna)
+     * @param vertice Vértice de origem
+     * @param destino Buffer com pelo menos n posições
+     */
+    void copiarLinha(int vertice, double* destino) const;
+
+    /**
+     * Memória ocupada pelos custos (matriz ou adjacência esparsa), em bytes
+     */
+    size_t getBytesCustos() const;
+
+    /**
+     * Retorna os vizinhos de um vértice (arestas existentes, respeitando a poda)
+     * em ordem de ID, com os custos. Apenas na instância esparsa (isEsparsa());
+     * na matriz, use copiarLinha e existeAresta. Calculado uma vez e reutilizado;
+     * válido até a próxima alteração do grafo.
+     */
+    Vizinhanca getVizinhos(int vertice) const;
+
+    /**
+     * Retorna os vizinhos de um vértice ordenados por custo crescente
+     * (sem o próprio vértice). Calculado uma vez e reutilizado.
+     */
+    const std::vector<int>& getVizinhosOrdenados(int vertice) const;
+
+    /**
+     * Retorna todas as arestas (origem < destino, incluindo as da raiz) ordenadas
+     * por custo crescente. Calculada uma vez e reutilizada.
+     */
+    const std::vector<Aresta>& getArestasOrdenadas() const;
+
+    /**
+     * Pré-processamento: elimina as arestas que comprovadamente podem ficar fora
+     * de uma solução ótima. Regras (arestas da raiz nunca são eliminadas):
+     *   - d(i) + d(j) > Q: i e j não cabem na mesma subárvore
+     *   - c(i,j) > max(c(i,raiz), c(j,raiz)): trocar (i,j) pela ligação do filho
+     *     à raiz reduz o custo sem aumentar a demanda de nenhuma subárvore
+     * A máscara é mantida atualizada por setCapacidade/setDemanda/setCusto.
+     * @return Número de arestas (não direcionadas) eliminadas
+     */
+    int aplicarPoda();
+
+    int getNumArestasEliminadas() const;
+    int getNumArestasTotal() const;
+
+    /**
+     * Renumera os vértices internamente para melhorar a localidade de memória:
+     * a matriz, as demandas e os índices são permutados; os IDs do arquivo são
+     * preservados em getIdOriginal. A raiz passa a ser o vértice 0.
+     * @param ordem ordem[k] = vértice (numeração atual) que passa a ser o k-ésimo;
+     *              ordem[0] deve ser a raiz
+     */
+    void renumerar(const std::vector<int>& ordem);
+
+    /**
+     * Ordem por custo de ligação à raiz (a raiz primeiro)
+     */
+    std::vector<int> ordemPorRaiz() const;
+
+    /**
+     * Ordem de Cuthill-McKee sobre o grafo dos k vizinhos mais próximos,
+     * a partir da raiz (vizinhos visitados em ordem crescente de grau)
+     * @param k Número de vizinhos de cada vértice
+     */
+    std::vector<int> ordemCuthillMcKee(int k) const;
+
+    /**
+     * Conversão entre a numeração interna e a do arquivo
+     */
+    int getIdOriginal(int vertice) const;
+    int getIdInterno(int original) const;
+
+    /**
+     * Converte um vetor de pais entre a numeração interna e a do arquivo
+     */
+    std::vector<int> paisParaOriginal(const std::vector<int>& pais) const;
+    std::vector<int> paisParaInterno(const std::vector<int>& pais) const;
+
+    /**
+     * Hash FNV-1a de 64 bits do conteúdo da instância (n, raiz, demandas e
+     * custos, na numeração do arquivo; sem a capacidade). Identifica a
+     * instância independente do nome e da renumeração interna.
+     */
+    uint64_t hashConteudo() const;
+
+    /**
+     * Calcula antecipadamente os índices derivados da matriz
+     * (necessário antes de compartilhar o grafo entre threads)
+     */
+    void prepararIndices() const;
 
     // Setters
     void setRaiz(int r);
     void setDemanda(int vertice, int demanda);
+    void setCapacidade(int cap);
     void setCusto(int origem, int destino, double custo);
 
+    /**
+     * Define o custo nos dois sentidos (mantém a representação compactada)
+     */
+    void setCustoSimetrico(int i, int j, double custo);
+
+    /**
+     * Acrescenta um vértice (novo terminal) ao grafo
+     * @param custosVertice Custo do novo vértice para cada vértice existente (simétrico)
+     * @param demanda Demanda do novo vértice
+     * @return ID do novo vértice
+     */
+    int adicionarVertice(const std::vector<double>& custosVertice, int demanda = 1);
+
     /**
      * Verifica se existe aresta entre dois vértices
      */
@@ -0,0 +1,46 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+ * Valor JSON mínimo, suficiente para o protocolo do servidor
+ * (objetos, listas, números, strings, booleanos e null)
+ */
+class ValorJSON {
+public:
+    enum Tipo { NULO, BOOLEANO, NUMERO, TEXTO, LISTA, OBJETO };
+
+    Tipo tipo;
+    bool booleano;
+    double numero;
+    std::string texto;
+    std::vector<ValorJSON> lista;
+    std::map<std::string, ValorJSON> objeto;
+
+    ValorJSON();
+
+    /**
+     * Lê um documento JSON completo
+     * @param entrada Texto do documento
+     * @param erro Recebe a descrição do erro de sintaxe, se houver
+     * @return true se o documento é válido
+     */
+    bool parsear(const std::string& entrada, std::string& erro);
+
+    /**
+     * Retorna o membro do objeto (nulo se não existir ou se não for objeto)
+     */
+    const ValorJSON* membro(const std::string& chave) const;
+
+    /**
+     * Leitura de membros com valor padrão (tipo incompatível = padrão)
+     */
+    double numeroOu(const std::string& chave, double padrao) const;
+    std::string textoOu(const std::string& chave, const std::string& padrao) const;
+    bool booleanoOu(const std::string& chave, bool padrao) const;
+};
+
+#endif // JSON_H
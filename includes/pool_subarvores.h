@@ -0,0 +1,98 @@
+#ifndef POOL_SUBARVORES_H
+#define POOL_SUBARVORES_H
+
+#include <vector>
+#include <unordered_map>
+#include <string>
+#include <cstdint>
+#include "grafo.h"
+#include "solucao.h"
+#include "utils.h"
+
+class Algoritmos;
+
+/**
+ * Subárvore da raiz guardada no pool (coluna do particionamento)
+ */
+struct ColunaPool {
+    std::vector<uint64_t> conjunto;  // Bitset dos vértices
+    std::vector<int> vertices;       // Vértices em ordem crescente
+    double custo;                    // Custo da MST do conjunto mais a raiz
+};
+
+/**
+ * Pool de subárvores com recombinação por particionamento de conjuntos
+ *
+ * Cada construção do GRASP passa suas subárvores da raiz ao pool; as que
+ * respeitam a capacidade e ainda não estão nele (chave = bitset dos vértices)
+ * entram com o custo da sua MST exata. A recombinação escolhe colunas
+ * disjuntas que cobrem todos os terminais com a menor soma de custos, por
+ * branch-and-bound em profundidade: ramifica no terminal descoberto com menos
+ * colunas, tentando as colunas por custo por vértice, e poda com o limite
+ * inferior sum_v min(custo(c) / |c|) dos terminais descobertos. O primeiro
+ * mergulho é a gulosa; o limite de nós interrompe a busca com a melhor
+ * partição encontrada.
+ */
+class PoolSubarvores {
+private:
+    const Grafo* grafo;
+    const Algoritmos* algoritmos;
+    int numPalavras;                                  // Palavras de 64 bits por bitset
+    std::vector<ColunaPool> colunas;
+    std::unordered_map<std::string, int> indice;      // Bitset (bytes) -> coluna
+    int novasDesdeRecombinacao;
+    int numRecombinacoes;
+    int numMelhorias;
+    double tempoSegundos;                             // Tempo gasto em adicionar e recombinar
+
+    /**
+     * Chave de hash do bitset
+     */
+    static std::string chave(const std::vector<uint64_t>& conjunto);
+
+    /**
+     * Branch-and-bound do particionamento (ver recombinar)
+     */
+    bool resolverParticao(double limiteSuperior, Solucao& solucao, long maxNos) const;
+
+public:
+    /**
+     * @param g Grafo da instância
+     * @param alg Algoritmos usados para a MST das subárvores (arvoreMinimaSubconjunto)
+     */
+    PoolSubarvores(const Grafo* g, const Algoritmos* alg);
+
+    /**
+     * Adiciona as subárvores da raiz de uma solução, completa ou parcial (os
+     * vértices desconectados são ignorados); subárvores que excedem a
+     * capacidade ou já presentes são descartadas
+     * @return Número de colunas novas
+     */
+    int adicionar(const Solucao& solucao);
+
+    /**
+     * Resolve o particionamento de conjuntos sobre o pool
+     * @param limiteSuperior Custo a superar (a incumbente)
+     * @param solucao Recebe a solução montada com as MSTs das colunas, se houver
+     * @param maxNos Máximo de nós do branch-and-bound
+     * @return true se encontrou partição de custo menor que limiteSuperior
+     */
+    bool recombinar(double limiteSuperior, Solucao& solucao, long maxNos);
+
+    /**
+     * Colunas adicionadas desde a última recombinação
+     */
+    int getNovasDesdeRecombinacao() const;
+
+    /**
+     * Número de colunas no pool
+     */
+    int tamanho() const;
+
+    /**
+     * Preenche a fase de recombinação do resultado (pool, particionamentos, melhorias e tempo)
+     */
+    void preencherResultado(ResultadoExecucao& resultado) const;
+};
+
+#endif // POOL_SUBARVORES_H
@@ -0,0 +1,59 @@
+#ifndef REPOSITORIO_H
+#define REPOSITORIO_H
+
+#include <string>
+#include <vector>
+#include "grafo.h"
+#include "solucao.h"
+
+/**
+ * Repositório persistente das melhores soluções conhecidas (warm start)
+ *
+ * Cada instância é identificada pelo hash do seu conteúdo (custos, demandas
+ * e raiz), independente do nome do arquivo, e cada capacidade Q tem sua
+ * própria entrada: <diretorio>/<hash>_q<Q>.sol
+ * Formato do arquivo:
+ *   Linha 1: custo da solução
+ *   Linha 2: n
+ *   Linha 3: vetor de pais (n inteiros)
+ */
+class RepositorioSolucoes {
+private:
+    std::string diretorio;
+
+    /**
+     * Caminho do arquivo da entrada (instância, Q)
+     */
+    std::string caminhoEntrada(const Grafo& grafo) const;
+
+    /**
+     * Lê uma entrada do disco
+     */
+    bool lerEntrada(const std::string& caminho, std::vector<int>& pais, double& custo) const;
+
+public:
+    /**
+     * Construtor
+     * @param dir Diretório do repositório (criado na primeira gravação, se não existir)
+     */
+    RepositorioSolucoes(const std::string& dir);
+
+    /**
+     * Carrega a melhor solução conhecida para a instância e Q atuais
+     * @param pais Recebe o vetor de pais
+     * @param custo Recebe o custo armazenado
+     * @return true se havia uma entrada válida
+     */
+    bool carregar(const Grafo& grafo, std::vector<int>& pais, double& custo) const;
+
+    /**
+     * Grava a solução se ela for viável e melhor que a armazenada.
+     * A escrita é atômica (arquivo temporário + rename) e serializada por flock()
+     * @return true se a entrada foi atualizada
+     */
+    bool salvarSeMelhor(const Grafo& grafo, const Solucao& solucao) const;
+
+    std::string getDiretorio() const;
+};
+
+#endif // REPOSITORIO_H
@@ -0,0 +1,140 @@
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <functional>
+#include <atomic>
+#include "grafo.h"
+#include "json.h"
+
+/**
+ * Fila de tarefas atendida por um número fixo de threads
+ */
+class PoolThreads {
+private:
+    std::vector<std::thread> threads;
+    std::deque<std::function<void()>> fila;
+    std::mutex mutex;
+    std::condition_variable condicao;
+    bool encerrando;
+
+    /**
+     * Laço de cada thread: retira e executa tarefas até o encerramento
+     */
+    void laco();
+
+public:
+    /**
+     * Construtor
+     * @param numThreads Número de threads (mínimo 1)
+     */
+    PoolThreads(int numThreads);
+
+    /**
+     * Destrutor: executa as tarefas pendentes e junta as threads
+     */
+    ~PoolThreads();
+
+    /**
+     * Enfileira uma tarefa
+     */
+    void enviar(std::function<void()> tarefa);
+};
+
+/**
+ * Conexão de um cliente: as respostas são gravadas por várias threads do
+ * pool, serializadas pelo mutex. O descritor é fechado quando a última
+ * referência (leitura ou tarefa pendente) deixa de existir.
+ */
+struct ConexaoCliente {
+    int fd;
+    std::mutex mutexEscrita;
+    std::string pendente;  // Bytes recebidos ainda sem '\n' (apenas a thread de E/S usa)
+
+    ConexaoCliente(int descritor);
+    ~ConexaoCliente();
+
+    /**
+     * Envia uma linha completa (a falha de escrita é ignorada: cliente desconectado)
+     */
+    void enviarLinha(const std::string& linha);
+};
+
+/**
+ * Servidor de soluções sobre socket Unix (cmst serve)
+ *
+ * Mantém as instâncias carregadas em memória, com os índices já calculados,
+ * e atende pedidos de vários clientes em paralelo num pool de threads.
+ * Protocolo JSON lines: cada linha recebida é um pedido e cada pedido recebe
+ * uma linha de resposta, com o mesmo "id". Pedidos de uma mesma conexão são
+ * executados em paralelo, então as respostas podem chegar fora de ordem.
+ *
+ * Operações ("op"):
+ *   resolver (padrão)  instancia | matriz, algoritmo, construtor, alpha, iter,
+ *                      alphas, bloco, politica, alpha_min, alpha_max, bracos,
+ *                      ilhas, migracao, abandono, troca_ciclica, recombinar,
+ *                      remocao, tempo, seed, capacidade
+ *   carregar           arquivo | matriz (+ nome), mantém a instância em memória
+ *   descartar          instancia, remove a instância da memória
+ *   ping               responde {"ok": true}
+ *   encerrar           termina os pedidos em andamento e encerra o servidor
+ */
+class ServidorCMST {
+private:
+    std::string caminhoSocket;
+    int numThreads;
+    bool verbose;
+    std::atomic<bool> encerrar;
+
+    // Instâncias residentes: chave = caminho do arquivo ou nome dado em "carregar"
+    std::mutex mutexInstancias;
+    std::map<std::string, std::shared_ptr<const Grafo>> instancias;
+
+    /**
+     * Retorna a instância residente, carregando-a do arquivo na primeira vez
+     * @return nulo se não existir (mensagem em erro)
+     */
+    std::shared_ptr<const Grafo> obterInstancia(const std::string& id, std::string& erro);
+
+    /**
+     * Monta uma instância a partir de "matriz" (lista de linhas ou lista plana
+     * n×n), "capacidade", "demandas" e "raiz" do pedido
+     * @return nulo se o pedido for inválido (mensagem em erro)
+     */
+    std::shared_ptr<Grafo> montarInstancia(const ValorJSON& pedido, std::string& erro) const;
+
+    /**
+     * Processa uma linha do protocolo e devolve a linha de resposta
+     */
+    std::string processar(const std::string& linha);
+
+    /**
+     * Operação resolver: executa o algoritmo pedido
+     * @return Campos da resposta (sem chaves externas)
+     */
+    std::string resolver(const ValorJSON& pedido, bool& ok);
+
+public:
+    /**
+     * Construtor
+     * @param caminho Caminho do socket Unix (recriado se já existir)
+     * @param threads Número de threads de solução (<= 0 = núcleos disponíveis)
+     * @param detalhado Registra cada pedido em stderr
+     */
+    ServidorCMST(const std::string& caminho, int threads, bool detalhado);
+
+    /**
+     * Atende conexões até receber "encerrar"
+     * @return false se não foi possível abrir o socket
+     */
+    bool executar();
+};
+
+#endif // SERVIDOR_H
@@ -0,0 +1,81 @@
+#ifndef SINTONIA_H
+#define SINTONIA_H
+
+#include <string>
+#include <vector>
+
+/**
+ * Configuração candidata do reativo na sintonia por corrida
+ */
+struct ConfiguracaoCandidata {
+    std::vector<double> alphas;
+    int tamanhoBloco;
+    int numIteracoes;
+
+    /**
+     * Opções de linha de comando equivalentes (--alphas ... --bloco ... --iter ...)
+     */
+    std::string descricao() const;
+};
+
+/**
+ * Parâmetros da sintonia (cmst tune)
+ */
+struct OpcoesSintonia {
+    std::vector<std::string> instancias;
+    std::vector<ConfiguracaoCandidata> candidatas;
+    int numSementes = 10;        // Sementes por instância (blocos = instâncias × sementes)
+    int blocosMinimos = 5;       // Blocos avaliados antes do primeiro teste
+    double nivel = 0.05;         // Nível de significância das eliminações
+    long orcamento = 0;          // Máximo de execuções por classe (0 = sem limite)
+    int numThreads = 0;          // Execuções simultâneas (<= 0 = núcleos disponíveis)
+    unsigned int sementeBase = 1;
+    bool verbose = false;
+};
+
+/**
+ * Resultado da corrida de uma classe de instâncias
+ */
+struct ResultadoSintonia {
+    std::string classe;
+    int numInstancias;
+    std::vector<int> sobreviventes;  // Índices das candidatas não eliminadas
+    std::vector<double> postoMedio;  // Posto médio de cada sobrevivente (mesma ordem)
+    int escolhida;                   // Índice da configuração recomendada
+    bool conclusiva;                 // Algum teste de Friedman foi significativo (houve eliminação)
+    int blocosAvaliados;
+    int blocosTotais;
+    long execucoes;
+    long execucoesGrade;             // Execuções da grade completa (candidatas × blocos)
+};
+
+/**
+ * Sintonia do reativo por corrida (F-race): as instâncias são agrupadas em
+ * classes (prefixo do nome, n e Q) e cada classe tem a sua corrida. A cada
+ * bloco (uma instância com uma semente, a mesma para todas as candidatas), as
+ * candidatas sobreviventes são executadas em paralelo; a partir de blocosMinimos,
+ * o teste de Friedman elimina as que têm soma de postos pior que a da melhor
+ * além da diferença crítica de Conover. A corrida para com uma sobrevivente, ao
+ * fim dos blocos ou do orçamento. Se algum teste foi significativo, as
+ * sobreviventes são estatisticamente equivalentes e é recomendada a de menos
+ * iterações (empate: menor posto médio). Se nenhum foi (corrida curta demais ou
+ * sem diferenças detectadas), a corrida é inconclusiva e é recomendada a de
+ * menor posto médio (empate: menos iterações).
+ */
+namespace Sintonia {
+    /**
+     * Produto cartesiano das listas de alphas, blocos e iterações
+     */
+    std::vector<ConfiguracaoCandidata> montarGrade(const std::vector<std::vector<double>>& conjuntosAlphas,
+                                                   const std::vector<int>& blocos,
+                                                   const std::vector<int>& iteracoes);
+
+    /**
+     * Executa uma corrida por classe de instâncias
+     * @param erro Recebe a mensagem se alguma instância não puder ser carregada
+     * @return Um resultado por classe, em ordem de nome (vazio em caso de erro)
+     */
+    std::vector<ResultadoSintonia> executar(const OpcoesSintonia& opcoes, std::string& erro);
+}
+
+#endif // SINTONIA_H
@@ -16,13 +16,18 @@ private:
     const Grafo* grafo;                    // Referência ao grafo
     std::vector<int> pai;                  // pai[i] = pai do vértice i na árvore (-1 para raiz)
     std::vector<int> subarvore;            // subarvore[i] = ID da subárvore do vértice i
+    std::vector<int> demandaSubarvore;     // demandaSubarvore[s - 1] = demanda da subárvore s
     double custoTotal;                     // Custo total da solução
     bool valida;                           // Indica se a solução é válida
 
     /**
-     * Identifica as subárvores (DFS a partir dos filhos da raiz)
+     * Identifica as subárvores e suas demandas em O(n): cada vértice sobe pelos
+     * pais até a raiz ou até um vértice já resolvido, e o caminho percorrido herda
+     * a subárvore encontrada. Vértices em ciclo, sem pai ou com pai inexistente (e
+     * os que dependem deles) ficam com subárvore -1.
+     * @return false se houver ciclo ou pai fora do intervalo de vértices
      */
-    void identificarSubarvores();
+    bool identificarSubarvores();
 
 public:
     /**
@@ -76,8 +81,10 @@ public:
     double getCustoTotal() const;
 
     /**
-     * Verifica se a solução é viável (respeita capacidade)
-     * @return true se todas as subárvores respeitam a capacidade
+     * Verifica a solução em O(n): sem ciclos, todos os vértices alcançam a raiz e
+     * todas as subárvores respeitam a capacidade. Na mesma passada recalcula o custo
+     * total e atualiza as subárvores e suas demandas.
+     * @return true se a solução é uma árvore geradora viável
      */
     bool verificarViabilidade();
 
@@ -87,7 +94,7 @@ public:
     bool isValida() const;
 
     /**
-     * Calcula a demanda total de uma subárvore
+     * Demanda total de uma subárvore (calculada por verificarViabilidade)
      * @param idSubarvore ID da subárvore
      * @return Soma das demandas dos vértices na subárvore
      */
@@ -0,0 +1,119 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include "fila_spsc.h"
+
+/**
+ * Evento de uma iteração no trace de convergência (registro binário de tamanho fixo)
+ */
+struct EventoTrace {
+    uint64_t instante;     // Nanossegundos desde a abertura do trace
+    double custo;          // Custo da construção (limite inferior, se abandonada)
+    double incumbente;     // Melhor custo viável após a iteração
+    int32_t iteracao;
+    int16_t alphaIdx;      // Índice do alpha (0 no randomizado)
+    uint8_t viavel;        // 1 se a solução construída respeita a capacidade
+    uint8_t abandonada;    // 1 se a construção foi abandonada pelo limite inferior
+};
+
+static_assert(sizeof(EventoTrace) == 32, "EventoTrace deve ter 32 bytes");
+
+/**
+ * Trace binário de convergência (--trace)
+ *
+ * A thread da busca grava cada evento numa fila circular pré-alocada sem travas
+ * (FilaSPSC), e uma thread de escrita a esvazia no arquivo em lotes. Na thread
+ * da busca o custo é uma leitura do relógio e uma cópia de 32 bytes, sem
+ * alocação nem chamada ao sistema. Se a fila encher, o evento é descartado e
+ * contado, nunca bloqueia a busca.
+ *
+ * Formato (ordem de bytes da máquina): cabeçalho de 32 bytes com a assinatura
+ * "CMSTTRC1", a versão, o tamanho do evento, o número de eventos gravados e o
+ * de descartados, seguido dos eventos. As contagens são preenchidas no
+ * fechamento; um arquivo não fechado é lido até o último evento completo.
+ */
+class RegistroTrace {
+private:
+    FilaSPSC<EventoTrace> fila;
+    FILE* arquivo;
+    std::thread escritor;
+    std::atomic<bool> encerrando;
+    std::atomic<uint64_t> descartados;
+    uint64_t gravados;     // Apenas a thread de escrita altera (lido após o join)
+    std::chrono::steady_clock::time_point inicio;
+
+    /**
+     * Laço da thread de escrita: esvazia a fila em lotes até o fechamento
+     */
+    void laco();
+
+public:
+    static const size_t CAPACIDADE_PADRAO = 1 << 16;  // Eventos na fila (2 MB)
+
+    /**
+     * Construtor
+     * @param capacidade Número de eventos que a fila comporta
+     */
+    explicit RegistroTrace(size_t capacidade = CAPACIDADE_PADRAO);
+
+    /**
+     * Destrutor: fecha o trace, se aberto
+     */
+    ~RegistroTrace();
+
+    RegistroTrace(const RegistroTrace&) = delete;
+    RegistroTrace& operator=(const RegistroTrace&) = delete;
+
+    /**
+     * Cria o arquivo, grava o cabeçalho e inicia a thread de escrita
+     * @return false se o arquivo não pôde ser criado
+     */
+    bool abrir(const std::string& nomeArquivo);
+
+    /**
+     * Grava os eventos pendentes, completa o cabeçalho e fecha o arquivo
+     */
+    void fechar();
+
+    /**
+     * Registra uma iteração (apenas a thread da busca)
+     */
+    void registrar(int iteracao, int alphaIdx, double custo, bool viavel, bool abandonada, double incumbente) {
+        EventoTrace e;
+        e.instante = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - inicio).count();
+        e.custo = custo;
+        e.incumbente = incumbente;
+        e.iteracao = iteracao;
+        e.alphaIdx = (int16_t)alphaIdx;
+        e.viavel = viavel ? 1 : 0;
+        e.abandonada = abandonada ? 1 : 0;
+        if (!fila.enviar(std::move(e))) {
+            descartados.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Número de eventos descartados por fila cheia
+     */
+    uint64_t getDescartados() const;
+
+    /**
+     * Converte um trace binário em CSV (instante_s, iteracao, alpha_idx, custo,
+     * viavel, abandonada, incumbente)
+     * @param nomeArquivo Trace gravado por --trace
+     * @param saida Destino do CSV
+     * @param erro Recebe a mensagem se o arquivo for inválido
+     * @return Número de eventos convertidos, ou -1 em caso de erro
+     */
+    static long converterCSV(const std::string& nomeArquivo, std::ostream& saida, std::string& erro);
+};
+
+#endif // TRACE_H
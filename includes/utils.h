@@ -5,15 +5,20 @@
 #include <random>
 #include <chrono>
 #include <fstream>
+#include <vector>
+#include <atomic>
+#include <functional>
 
 /**
- * Classe utilitária para gerenciamento de randomização
+ * Classe utilitária para gerenciamento de randomização.
+ * O estado é por thread: execuções simultâneas (servidor) não compartilham o
+ * gerador, e cada uma é reprodutível pela semente inicializada na sua thread.
  */
 class Randomizador {
 private:
-    static std::mt19937 gerador;
-    static unsigned int sementeAtual;
-    static bool inicializado;
+    static thread_local std::mt19937 gerador;
+    static thread_local unsigned int sementeAtual;
+    static thread_local bool inicializado;
 
 public:
     /**
@@ -52,6 +57,17 @@ public:
      * Retorna referência ao gerador (para uso com std::shuffle, etc.)
      */
     static std::mt19937& getGerador();
+
+    /**
+     * Grava semente e estado completo do gerador (para checkpoint)
+     */
+    static void salvarEstado(std::ostream& out);
+
+    /**
+     * Restaura semente e estado do gerador
+     * @return false se a leitura falhou (gerador inalterado)
+     */
+    static bool carregarEstado(std::istream& in);
 };
 
 /**
@@ -87,6 +103,55 @@ public:
     double getTempoMilissegundos() const;
 };
 
+/**
+ * Progresso de uma execução, repassado ao callback de progresso
+ */
+struct ProgressoExecucao {
+    int iteracao;           // Iterações concluídas
+    int totalIteracoes;     // Limite de iterações
+    double melhorCusto;     // Melhor custo viável até o momento (INFINITO se nenhum)
+    double tempoSegundos;   // Tempo decorrido
+};
+
+/**
+ * Controle externo de uma execução: token de cancelamento e callback de progresso.
+ * Os algoritmos consultam o token uma vez por iteração; ao ser cancelada, a
+ * execução termina normalmente e devolve a melhor solução encontrada até ali.
+ * cancelar() pode ser chamado de qualquer thread.
+ */
+class ControleExecucao {
+private:
+    std::atomic<bool> cancelado;
+    std::function<void(const ProgressoExecucao&)> callback;
+    int intervalo;          // Iterações entre chamadas do callback
+
+public:
+    ControleExecucao();
+
+    /**
+     * Pede o cancelamento da execução em andamento
+     */
+    void cancelar();
+
+    /**
+     * Retorna se o cancelamento foi pedido
+     */
+    bool isCancelado() const;
+
+    /**
+     * Define o callback de progresso (chamado na thread da execução)
+     * @param funcao Callback (vazio para remover)
+     * @param intervaloIteracoes Chama o callback a cada intervaloIteracoes iterações
+     */
+    void setCallbackProgresso(std::function<void(const ProgressoExecucao&)> funcao,
+                              int intervaloIteracoes = 1);
+
+    /**
+     * Chamado pelos algoritmos ao fim de cada iteração
+     */
+    void reportar(int iteracao, int totalIteracoes, double melhorCusto, double tempoSegundos) const;
+};
+
 /**
  * Estrutura para armazenar resultado de uma execução
  */
@@ -96,6 +161,7 @@ struct ResultadoExecucao {
     int numVertices;
     int capacidade;
     std::string algoritmo;
+    std::string construtor; // Motor construtivo (prim/kruskal)
     double alpha;           // -1 se não aplicável
     int iteracoes;          // -1 se não aplicável
     int tamanhoBloco;       // -1 se não aplicável
@@ -104,42 +170,107 @@ struct ResultadoExecucao {
     double melhorSolucao;
     double mediaSolucoes;   // -1 se não aplicável
     double melhorAlpha;     // -1 se não aplicável
+    double taxaAbandono;    // Fração das construções abandonadas pelo limite (-1 se não aplicável)
+    int tamanhoPool;        // Fase de recombinação: subárvores no pool (-1 se desativada)
+    int recombinacoes;      // Particionamentos resolvidos
+    int melhoriasRecombinacao;  // Particionamentos que superaram a incumbente
+    double tempoRecombinacao;   // Segundos gastos no pool e nos particionamentos
     double solucaoOtima;    // -1 se não disponível
+    std::string politicaAlpha;  // Seleção de alpha do reativo (vazio se não aplicável)
+    std::string opcoes;     // Opções que alteram a busca, separadas por espaço (ex.: "troca-ciclica poda")
 
     ResultadoExecucao();
 };
 
 /**
- * Classe para escrita de resultados em CSV
+ * Base dos escritores de resultados: acumula linhas em memória e descarrega
+ * em lote com uma única chamada write() em modo O_APPEND, de modo que várias
+ * execuções simultâneas de cmst anexando ao mesmo arquivo não intercalem
+ * linhas. Opcionalmente usa flock() para serializar também o cabeçalho.
+ * O cabeçalho é recebido no construtor (e não por método virtual) porque o
+ * destrutor também descarrega o buffer.
  */
-class EscritorCSV {
+class EscritorBufferizado {
 private:
     std::string nomeArquivo;
+    std::string textoCabecalho;  // Gravado quando o arquivo está vazio e exigido num arquivo existente (vazio = sem cabeçalho)
+    std::string buffer;        // Linhas ainda não gravadas
+    int linhasPendentes;
+    bool usarLock;
 
+protected:
     /**
-     * Verifica se o arquivo existe e tem cabeçalho
+     * Acrescenta uma linha completa (terminada em '\n') ao buffer
      */
-    bool arquivoExiste() const;
+    void anexarLinha(const std::string& linha);
 
 public:
+    // Linhas acumuladas antes de um descarregamento automático
+    static const int TAMANHO_LOTE = 64;
+
     /**
      * Construtor
-     * @param arquivo Nome do arquivo CSV
+     * @param arquivo Nome do arquivo de saída
+     * @param cabecalho Cabeçalho gravado quando o arquivo está vazio (vazio = sem cabeçalho)
+     * @param lock Usa flock() exclusivo durante a gravação
      */
-    EscritorCSV(const std::string& arquivo);
+    EscritorBufferizado(const std::string& arquivo, const std::string& cabecalho, bool lock = false);
 
     /**
-     * Escreve o cabeçalho do CSV (se arquivo não existir)
+     * Destrutor (descarrega o buffer)
      */
-    void escreverCabecalho();
+    virtual ~EscritorBufferizado();
 
     /**
-     * Escreve uma linha de resultado
+     * Grava as linhas pendentes com uma única escrita atômica
+     * @return true se gravou com sucesso; false também se o arquivo já existe
+     *         com outro cabeçalho (as linhas pendentes são descartadas)
+     */
+    bool descarregar();
+
+    std::string getNomeArquivo() const;
+};
+
+/**
+ * Classe para escrita de resultados em CSV
+ */
+class EscritorCSV : public EscritorBufferizado {
+public:
+    /**
+     * Construtor
+     * @param arquivo Nome do arquivo CSV
+     * @param lock Usa flock() exclusivo durante a gravação
+     */
+    EscritorCSV(const std::string& arquivo, bool lock = false);
+
+    /**
+     * Acrescenta uma linha de resultado (gravada no próximo descarregamento)
      * @param resultado Estrutura com os dados da execução
      */
     void escreverResultado(const ResultadoExecucao& resultado);
 };
 
+/**
+ * Classe para escrita de resultados em JSON lines (um objeto por execução),
+ * incluindo a solução (vetor de pais) e as métricas da execução
+ */
+class EscritorJSONL : public EscritorBufferizado {
+public:
+    /**
+     * Construtor
+     * @param arquivo Nome do arquivo .jsonl
+     * @param lock Usa flock() exclusivo durante a gravação
+     */
+    EscritorJSONL(const std::string& arquivo, bool lock = false);
+
+    /**
+     * Acrescenta um registro de resultado
+     * @param resultado Estrutura com os dados da execução
+     * @param pais Vetor de pais da melhor solução
+     */
+    void escreverResultado(const ResultadoExecucao& resultado, const std::vector<int>& pais);
+};
+
 /**
  * Funções auxiliares
  */
@@ -153,6 +284,18 @@ namespace Utils {
      * Formata um número double para string com precisão específica
      */
     std::string formatarDouble(double valor, int precisao = 2);
+
+    /**
+     * Escapa uma string para uso como valor JSON (sem as aspas externas)
+     */
+    std::string escaparJSON(const std::string& texto);
+
+    /**
+     * Grava um arquivo de forma atômica: escreve em um temporário no mesmo
+     * diretório, faz fsync e renomeia sobre o destino
+     * @return true se gravou com sucesso
+     */
+    bool gravarArquivoAtomico(const std::string& caminho, const std::string& conteudo);
 }
 
 #endif // UTILS_H
@@ -0,0 +1,122 @@
+#!/bin/bash
+
+# Teste de regressão de desempenho: executa casos com semente fixa e compara
+# o custo obtido com o valor de referência (igualdade exata) e o tempo com o
+# orçamento de cada caso. Termina com código 1 se algum caso falhar.
+#
+# Uso: perftest/perftest.sh [--atualizar]
+#   --atualizar  regrava as referências com os valores medidos agora
+#                (orçamento = max(ORCAMENTO_MINIMO, FOLGA × tempo medido))
+#
+# Variáveis de ambiente:
+#   FATOR_ORCAMENTO  multiplica os orçamentos (máquinas mais lentas), default: 1
+
+DIRETORIO=$(cd "$(dirname "$0")" && pwd)
+RAIZ=$(cd "$DIRETORIO/.." && pwd)
+REFERENCIAS="$DIRETORIO/referencias.csv"
+EXECUTAVEL="$RAIZ/cmst"
+INSTANCIAS_DIR="$RAIZ/capmstnew"
+
+FATOR_ORCAMENTO=${FATOR_ORCAMENTO:-1}
+FOLGA=4
+ORCAMENTO_MINIMO=0.5
+
+ATUALIZAR=0
+if [ "$1" == "--atualizar" ]; then
+    ATUALIZAR=1
+fi
+
+if [ ! -x "$EXECUTAVEL" ]; then
+    echo "Erro: executável 'cmst' não encontrado! Compile com 'make'"
+    exit 1
+fi
+
+if [ ! -f "$REFERENCIAS" ]; then
+    echo "Erro: arquivo de referências '$REFERENCIAS' não encontrado!"
+    exit 1
+fi
+
+TEMP=$(mktemp -d)
+trap 'rm -rf "$TEMP"' EXIT
+
+# Executa um caso e imprime "custo tempo" (colunas melhor_solucao e tempo_segundos do CSV)
+executar_caso() {
+    local instancia=$1
+    local algoritmo=$2
+    local opcoes=$3
+
+    rm -f "$TEMP/r.csv"
+    # shellcheck disable=SC2086
+    "$EXECUTAVEL" "$INSTANCIAS_DIR/$instancia" "$algoritmo" $opcoes --csv "$TEMP/r.csv" > /dev/null 2>&1
+    if [ ! -f "$TEMP/r.csv" ]; then
+        echo "erro erro"
+        return
+    fi
+    tail -n 1 "$TEMP/r.csv" | awk -F',' '{ print $11, $10 }'
+}
+
+total=0
+falhas=0
+relatorio=""
+novas="instancia,algoritmo,opcoes,custo,orcamento_segundos"
+
+printf "%-6s %-13s %-11s %-50s %10s %10s %9s %9s\n" \
+    "STATUS" "INSTANCIA" "ALGORITMO" "OPCOES" "ESPERADO" "OBTIDO" "TEMPO" "ORCAMENTO"
+
+while IFS=',' read -r instancia algoritmo opcoes custo orcamento; do
+    if [ "$instancia" == "instancia" ] || [ -z "$instancia" ]; then
+        continue
+    fi
+    total=$((total + 1))
+
+    read -r obtido tempo <<< "$(executar_caso "$instancia" "$algoritmo" "$opcoes")"
+
+    if [ $ATUALIZAR -eq 1 ]; then
+        orcamento=$(awk -v t="$tempo" -v f=$FOLGA -v m=$ORCAMENTO_MINIMO \
+            'BEGIN { o = t * f; if (o < m) o = m; printf "%.1f", o + 0.05 }')
+        novas="$novas"$'\n'"$instancia,$algoritmo,$opcoes,$obtido,$orcamento"
+        printf "%-6s %-13s %-11s %-50s %10s %10s %9s %9s\n" \
+            "NOVO" "$instancia" "$algoritmo" "$opcoes" "$custo" "$obtido" "$tempo" "$orcamento"
+        continue
+    fi
+
+    limite=$(awk -v o="$orcamento" -v f="$FATOR_ORCAMENTO" 'BEGIN { printf "%.3f", o * f }')
+    status="OK"
+    motivo=""
+    if [ "$obtido" != "$custo" ]; then
+        status="FALHA"
+        motivo="custo $custo -> $obtido"
+    fi
+    if [ "$tempo" == "erro" ] || awk -v t="$tempo" -v l="$limite" 'BEGIN { exit !(t > l) }'; then
+        status="FALHA"
+        motivo="${motivo:+$motivo; }tempo ${tempo}s > orçamento ${limite}s"
+    fi
+
+    printf "%-6s %-13s %-11s %-50s %10s %10s %9s %9s\n" \
+        "$status" "$instancia" "$algoritmo" "$opcoes" "$custo" "$obtido" "$tempo" "$limite"
+
+    if [ "$status" != "OK" ]; then
+        falhas=$((falhas + 1))
+        relatorio="$relatorio"$'\n'"  $instancia $algoritmo $opcoes: $motivo"
+    fi
+done < "$REFERENCIAS"
+
+if [ $ATUALIZAR -eq 1 ]; then
+    echo "$novas" > "$REFERENCIAS"
+    echo ""
+    echo "Referências atualizadas: $total casos gravados em $REFERENCIAS"
+    exit 0
+fi
+
+echo ""
+if [ $falhas -gt 0 ]; then
+    echo "=== Diferenças em relação às referências ==="
+    echo "  (custo esperado -> obtido; tempo medido > orçamento)"
+    echo "$relatorio" | tail -n +2
+    echo ""
+    echo "perftest: $falhas de $total casos falharam"
+    exit 1
+fi
+
+echo "perftest: $total casos OK"
+exit 0
@@ -2,9 +2,136 @@
 #include <algorithm>
 #include <cmath>
 #include <map>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <atomic>
+#include <random>
+#include <omp.h>
+#include "../includes/fila_spsc.h"
+#include "../includes/pool_subarvores.h"
+
+// ==================== EdicaoInstancia ====================
+
+void EdicaoInstancia::aplicar(Grafo& grafo) const {
+    for (const AlteracaoCusto& a : custos) {
+        grafo.setCustoSimetrico(a.origem, a.destino, a.custo);
+    }
+    for (const AlteracaoDemanda& a : demandas) {
+        grafo.setDemanda(a.vertice, a.demanda);
+    }
+    for (const NovoTerminal& t : novosTerminais) {
+        grafo.adicionarVertice(t.custos, t.demanda);
+    }
+}
+
+EdicaoInstancia EdicaoInstancia::paraIdsInternos(const Grafo& grafo) const {
+    int n = grafo.getNumVertices();
+    auto interno = [&grafo, n](int v) {
+        return (v >= 0 && v < n) ? grafo.getIdInterno(v) : v;
+    };
+    
+    EdicaoInstancia traduzida(*this);
+    for (AlteracaoCusto& a : traduzida.custos) {
+        a.origem = interno(a.origem);
+        a.destino = interno(a.destino);
+    }
+    for (AlteracaoDemanda& a : traduzida.demandas) {
+        a.vertice = interno(a.vertice);
+    }
+    
+    // Custos dos novos terminais: posições dos vértices originais permutadas;
+    // terminais anteriores (IDs >= n) mantêm a posição
+    for (NovoTerminal& t : traduzida.novosTerminais) {
+        std::vector<double> custos = t.custos;
+        for (int o = 0; o < n && o < (int)t.custos.size(); o++) {
+            custos[grafo.getIdInterno(o)] = t.custos[o];
+        }
+        t.custos.swap(custos);
+    }
+    return traduzida;
+}
+
+bool EdicaoInstancia::carregar(const std::string& nomeArquivo, int numVertices) {
+    std::ifstream arquivo(nomeArquivo);
+    if (!arquivo.is_open()) {
+        std::cerr << "Erro: Não foi possível abrir o arquivo de edições '" << nomeArquivo << "'" << std::endl;
+        return false;
+    }
+    
+    std::string linha;
+    int numLinha = 0;
+    while (std::getline(arquivo, linha)) {
+        numLinha++;
+        std::istringstream iss(linha);
+        std::string tipo;
+        if (!(iss >> tipo) || tipo[0] == '#') {
+            continue;
+        }
+        
+        // Vértices fora da instância seriam ignorados pelo grafo em silêncio
+        auto valido = [numVertices](int v) { return v >= 0 && v < numVertices; };
+        bool ok = false;
+        std::string motivo;
+        if (tipo == "custo") {
+            AlteracaoCusto a;
+            ok = (bool)(iss >> a.origem >> a.destino >> a.custo);
+            if (ok && (!valido(a.origem) || !valido(a.destino) || a.origem == a.destino)) {
+                ok = false;
+                motivo = "enlace " + std::to_string(a.origem) + "-" + std::to_string(a.destino) +
+                         " inexistente (vértices 0.." + std::to_string(numVertices - 1) + ")";
+            }
+            if (ok) custos.push_back(a);
+        } else if (tipo == "demanda") {
+            AlteracaoDemanda a;
+            ok = (bool)(iss >> a.vertice >> a.demanda);
+            if (ok && !valido(a.vertice)) {
+                ok = false;
+                motivo = "vértice " + std::to_string(a.vertice) + " inexistente (vértices 0.." +
+                         std::to_string(numVertices - 1) + ")";
+            } else if (ok && a.demanda < 0) {
+                ok = false;
+                motivo = "demanda negativa";
+            }
+            if (ok) demandas.push_back(a);
+        } else if (tipo == "terminal") {
+            NovoTerminal t;
+            ok = (bool)(iss >> t.demanda);
+            double c;
+            while (iss >> c) {
+                t.custos.push_back(c);
+            }
+            ok = ok && !t.custos.empty();
+            // Custos para os vértices existentes, incluindo os terminais anteriores
+            int existentes = numVertices + (int)novosTerminais.size();
+            if (ok && (int)t.custos.size() > existentes) {
+                ok = false;
+                motivo = std::to_string(t.custos.size()) + " custos para " + std::to_string(existentes) +
+                         " vértices existentes";
+            } else if (ok && t.demanda < 0) {
+                ok = false;
+                motivo = "demanda negativa";
+            }
+            if (ok) novosTerminais.push_back(t);
+        }
+        
+        if (!ok) {
+            std::cerr << "Erro: linha " << numLinha << " inválida em '" << nomeArquivo << "'"
+                      << (motivo.empty() ? "" : ": " + motivo) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// ==================== Algoritmos ====================
 
 // Construtor
-Algoritmos::Algoritmos(const Grafo* g) : grafo(g), proximoSubId(1), cacheValido(false) {
+Algoritmos::Algoritmos(const Grafo* g)
+    : grafo(g), proximoSubId(1), cacheValido(false), construtor("prim"), controle(nullptr),
+      politicaAlpha("roleta"), larguraAlpha(0), abandono(false), usarTrocaCiclica(false), intervaloRecombinacao(0), trace(nullptr),
+      intervaloCheckpoint(50),
+      retomarCheckpoint(false), checkpointRecusado(false) {
     int n = g->getNumVertices();
     demandaSubarvore.resize(n + 1, 0);  // Reserve space for subtrees (1-indexed)
     subarvoreVertice.resize(n, -1);
@@ -18,7 +145,11 @@ void Algoritmos::inicializarCache(const Solucao& solucao) const {
     int n = grafo->getNumVertices();
     int raiz = grafo->getRaiz();
     
-    // Reset cache
+    // Reset cache (o grafo pode ter ganho vértices desde a construção)
+    if ((int)subarvoreVertice.size() != n) {
+        subarvoreVertice.assign(n, -1);
+        demandaSubarvore.assign(n + 1, 0);
+    }
     std::fill(demandaSubarvore.begin(), demandaSubarvore.end(), 0);
     std::fill(subarvoreVertice.begin(), subarvoreVertice.end(), -1);
     filhoRaizParaSubId.clear();
@@ -250,19 +381,35 @@ std::vector<Candidato> Algoritmos::gerarCandidatos(const Solucao& solucao, const
     std::vector<Candidato> candidatos;
     candidatos.reserve(naoConectados.size() * conectadosList.size() / 4);  // Estimativa conservadora
     
-    // Iterar apenas sobre listas filtradas
-    for (int v : naoConectados) {
-        for (int p : conectadosList) {
-            // Verificar se existe aresta
-            if (!grafo->existeAresta(v, p)) continue;
-            
-            // Verificar se respeita a capacidade
-            if (!podeAdicionar(solucao, v, p)) continue;
-            
-            // Candidato válido
-            double custo = grafo->getCusto(v, p);
-            int subarvore = encontrarSubarvore(solucao, p);
-            candidatos.emplace_back(v, p, custo, subarvore);
+    if (grafo->isEsparsa()) {
+        // Instância esparsa: só as arestas de v (adjacência em ordem de ID), O(grau)
+        for (int v : naoConectados) {
+            Vizinhanca vizinhos = grafo->getVizinhos(v);
+            for (int k = 0; k < vizinhos.grau; k++) {
+                int p = vizinhos.vertices[k];
+                if (!conectados[p]) continue;
+                if (!podeAdicionar(solucao, v, p)) continue;
+                candidatos.emplace_back(v, p, vizinhos.custos[k], encontrarSubarvore(solucao, p));
+            }
+        }
+    } else {
+        // Iterar apenas sobre listas filtradas; os custos de v são lidos de uma cópia
+        // contígua da sua linha (o armazenamento compactado guarda metade dela por coluna)
+        std::vector<double> linha(n);
+        for (int v : naoConectados) {
+            grafo->copiarLinha(v, linha.data());
+            for (int p : conectadosList) {
+                // Verificar se existe aresta
+                if (!grafo->existeAresta(v, p)) continue;
+                
+                // Verificar se respeita a capacidade
+                if (!podeAdicionar(solucao, v, p)) continue;
+                
+                // Candidato válido
+                double custo = linha[p];
+                int subarvore = encontrarSubarvore(solucao, p);
+                candidatos.emplace_back(v, p, custo, subarvore);
+            }
         }
     }
     
@@ -274,6 +421,10 @@ std::vector<Candidato> Algoritmos::gerarCandidatos(const Solucao& solucao, const
 
 // Construção gulosa pura
 Solucao Algoritmos::construirGuloso() const {
+    if (construtor == "kruskal") {
+        return construirKruskal(0.0);
+    }
+    
     Solucao solucao(grafo);
     int n = grafo->getNumVertices();
     int raiz = grafo->getRaiz();
@@ -330,17 +481,250 @@ Solucao Algoritmos::construirGuloso() const {
 }
 
 // Construção gulosa randomizada
-Solucao Algoritmos::construirGulosoRandomizado(double alpha) const {
+Solucao Algoritmos::construirGulosoRandomizado(double alpha, double limiteAbandono, double* limiteInferior) const {
+    if (construtor == "kruskal") {
+        return construirKruskal(alpha, limiteAbandono, limiteInferior);
+    }
+    return completarGulosoRandomizado(Solucao(grafo), alpha, limiteAbandono, limiteInferior);
+}
+
+// Aresta mais barata que sai do vértice (0 se não houver nenhuma)
+double Algoritmos::menorAresta(int vertice) const {
+    const std::vector<int>& vizinhos = grafo->getVizinhosOrdenados(vertice);
+    return vizinhos.empty() ? 0 : grafo->getCusto(vertice, vizinhos[0]);
+}
+
+// Construção Kruskal capacitada com union-find
+Solucao Algoritmos::construirKruskal(double alpha, double limiteAbandono, double* limiteInferior) const {
+    if (limiteInferior != nullptr) {
+        *limiteInferior = -1;
+    }
+
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+    int capacidade = grafo->getCapacidade();
+    const std::vector<Aresta>& arestas = grafo->getArestasOrdenadas();
+    int m = arestas.size();
+    
+    // Union-find sobre os vértices não-raiz, com a demanda de cada componente e o
+    // custo da sua ligação mais barata à raiz
+    std::vector<int> representante(n);
+    std::vector<int> demanda(n);
+    std::vector<double> custoRaiz(n);
+    for (int v = 0; v < n; v++) {
+        representante[v] = v;
+        demanda[v] = grafo->getDemanda(v);
+        custoRaiz[v] = (v != raiz && grafo->existeAresta(v, raiz)) ? grafo->getCusto(v, raiz) : INFINITO;
+    }
+    auto encontrar = [&representante](int v) {
+        while (representante[v] != v) {
+            representante[v] = representante[representante[v]];
+            v = representante[v];
+        }
+        return v;
+    };
+    
+    // Salto sobre arestas descartadas: leva à próxima aresta ainda ativa >= k
+    std::vector<int> salto(m + 1);
+    for (int k = 0; k <= m; k++) {
+        salto[k] = k;
+    }
+    auto proximaAtiva = [&salto](int k) {
+        int r = k;
+        while (salto[r] != r) r = salto[r];
+        while (salto[k] != r) {
+            int prox = salto[k];
+            salto[k] = r;
+            k = prox;
+        }
+        return r;
+    };
+    
+    // Arestas da raiz ficam para o fim (cada componente usa a sua mais barata). Como no
+    // Esau-Williams, uma união só vale se a aresta custar menos que a ligação à raiz que
+    // ela substitui. Uma aresta inviável agora é inviável para sempre: demandas só
+    // crescem e custos de ligação à raiz só diminuem
+    auto viavel = [&](const Aresta& a) {
+        if (a.origem == raiz || a.destino == raiz) {
+            return false;
+        }
+        int ca = encontrar(a.origem);
+        int cb = encontrar(a.destino);
+        return ca != cb && demanda[ca] + demanda[cb] <= capacidade &&
+               a.custo < std::max(custoRaiz[ca], custoRaiz[cb]);
+    };
+    
+    int tamanhoJanela = 1 + (int)std::floor(alpha * (n - 1));
+    std::vector<int> janela;
+    janela.reserve(tamanhoJanela);
+    
     Solucao solucao(grafo);
+    std::vector<std::vector<int>> adjacentes(n);
+    double custoUnioes = 0;
+    
+    while (true) {
+        // Próximas arestas viáveis (as inviáveis encontradas no caminho são descartadas)
+        janela.clear();
+        for (int k = proximaAtiva(0); k < m && (int)janela.size() < tamanhoJanela; k = proximaAtiva(k + 1)) {
+            if (viavel(arestas[k])) {
+                janela.push_back(k);
+            } else {
+                salto[k] = k + 1;
+            }
+        }
+        if (janela.empty()) {
+            break;
+        }
+        
+        // Limite inferior do custo final: cada componente ainda paga a sua ligação à
+        // raiz ou uma união futura, que custa pelo menos a primeira aresta ativa
+        if (limiteAbandono < INFINITO) {
+            double menorFutura = arestas[janela[0]].custo;
+            double limite = custoUnioes;
+            for (int v = 0; v < n; v++) {
+                if (v != raiz && representante[v] == v) {
+                    limite += std::min(custoRaiz[v], menorFutura);
+                }
+            }
+            if (limite > limiteAbandono) {
+                if (limiteInferior != nullptr) {
+                    *limiteInferior = limite;
+                }
+                solucao.calcularCusto();
+                return solucao;
+            }
+        }
+        
+        int k = janela[janela.size() > 1 ? Randomizador::randInt(0, janela.size() - 1) : 0];
+        salto[k] = k + 1;
+        
+        const Aresta& a = arestas[k];
+        int ca = encontrar(a.origem);
+        int cb = encontrar(a.destino);
+        if (demanda[ca] < demanda[cb]) std::swap(ca, cb);
+        representante[cb] = ca;
+        demanda[ca] += demanda[cb];
+        custoRaiz[ca] = std::min(custoRaiz[ca], custoRaiz[cb]);
+        adjacentes[a.origem].push_back(a.destino);
+        adjacentes[a.destino].push_back(a.origem);
+        custoUnioes += a.custo;
+    }
+    
+    // Cada componente se liga à raiz pelo seu vértice mais próximo dela
+    std::vector<int> entradaRaiz(n, -1);
+    for (int v = 0; v < n; v++) {
+        if (v == raiz || !grafo->existeAresta(v, raiz)) continue;
+        int c = encontrar(v);
+        if (entradaRaiz[c] < 0 || grafo->getCusto(v, raiz) < grafo->getCusto(entradaRaiz[c], raiz)) {
+            entradaRaiz[c] = v;
+        }
+    }
+    
+    // Orientar cada componente a partir do vértice ligado à raiz
+    std::vector<char> visitado(n, 0);
+    std::vector<int> fila;
+    for (int c = 0; c < n; c++) {
+        int inicio = entradaRaiz[c];
+        if (inicio < 0) continue;
+        solucao.setPai(inicio, raiz);
+        visitado[inicio] = 1;
+        fila.assign(1, inicio);
+        for (size_t i = 0; i < fila.size(); i++) {
+            int v = fila[i];
+            for (int u : adjacentes[v]) {
+                if (!visitado[u]) {
+                    visitado[u] = 1;
+                    solucao.setPai(u, v);
+                    fila.push_back(u);
+                }
+            }
+        }
+    }
+    
+    solucao.calcularCusto();
+    solucao.verificarViabilidade();
+    
+    return solucao;
+}
+
+// Completa uma solução parcial com a inserção gulosa randomizada
+Solucao Algoritmos::completarGulosoRandomizado(const Solucao& parcial, double alpha,
+                                              double limiteAbandono, double* limiteInferior) const {
+    Solucao solucao(parcial);
     int n = grafo->getNumVertices();
     int raiz = grafo->getRaiz();
+    if (limiteInferior != nullptr) {
+        *limiteInferior = -1;
+    }
     
-    // Inicializar cache
+    // Inicializar cache (suporta subárvores já existentes na solução parcial)
     inicializarCache(solucao);
     
     std::vector<bool> conectados(n, false);
     conectados[raiz] = true;
     int numConectados = 1;
+    for (int v = 0; v < n; v++) {
+        if (v != raiz && solucao.getPai(v) != -1) {
+            conectados[v] = true;
+            numConectados++;
+        }
+    }
+    
+    // Limite inferior do custo final: custo parcial mais a aresta mais barata de
+    // cada vértice desconectado (cada um ainda recebe exatamente a aresta até o pai).
+    // Se a folga das subárvores existentes não comporta a demanda restante, surgem ao
+    // menos k novas subárvores, e k vértices desconectados trocam a aresta mais
+    // barata pela ligação à raiz: soma-se o menor acréscimo c(v,raiz) - menorAresta(v)
+    bool abandonar = limiteAbandono < INFINITO;
+    int capacidade = grafo->getCapacidade();
+    double custoParcial = 0;
+    double restante = 0;
+    int demandaRestante = 0;
+    int folga = 0;
+    std::vector<double> acrescimoRaiz;
+    if (abandonar) {
+        for (int v = 0; v < n; v++) {
+            if (v == raiz) continue;
+            if (conectados[v]) {
+                custoParcial += grafo->getCusto(v, solucao.getPai(v));
+                folga += (solucao.getPai(v) == raiz ? capacidade : 0) - grafo->getDemanda(v);
+            } else {
+                restante += menorAresta(v);
+                demandaRestante += grafo->getDemanda(v);
+            }
+        }
+        acrescimoRaiz.reserve(n);
+    }
+    auto conectar = [&](int v, int p, double custo) {
+        solucao.setPai(v, p);
+        conectados[v] = true;
+        numConectados++;
+        atualizarCacheDemanda(solucao, v, p);
+        if (abandonar) {
+            custoParcial += custo;
+            restante -= menorAresta(v);
+            demandaRestante -= grafo->getDemanda(v);
+            folga += (p == raiz ? capacidade : 0) - grafo->getDemanda(v);
+        }
+    };
+    auto limiteConclusao = [&]() {
+        double limite = custoParcial + restante;
+        int novasSubarvores = (demandaRestante - folga + capacidade - 1) / capacidade;
+        if (novasSubarvores > 0) {
+            acrescimoRaiz.clear();
+            for (int v = 0; v < n; v++) {
+                if (!conectados[v] && grafo->existeAresta(v, raiz)) {
+                    acrescimoRaiz.push_back(grafo->getCusto(v, raiz) - menorAresta(v));
+                }
+            }
+            int k = std::min(novasSubarvores, (int)acrescimoRaiz.size());
+            std::nth_element(acrescimoRaiz.begin(), acrescimoRaiz.begin() + (k > 0 ? k - 1 : 0), acrescimoRaiz.end());
+            for (int i = 0; i < k; i++) {
+                limite += acrescimoRaiz[i];
+            }
+        }
+        return limite;
+    };
     
     while (numConectados < n) {
         // Gerar candidatos
@@ -353,10 +737,7 @@ Solucao Algoritmos::construirGulosoRandomizado(double alpha) const {
                 if (!conectados[v] && grafo->existeAresta(v, raiz)) {
                     // Verificar capacidade (nova subárvore)
                     if (grafo->getDemanda(v) <= grafo->getCapacidade()) {
-                        solucao.setPai(v, raiz);
-                        conectados[v] = true;
-                        numConectados++;
-                        atualizarCacheDemanda(solucao, v, raiz);
+                        conectar(v, raiz, grafo->getCusto(v, raiz));
                         conectouAlgum = true;
                         break;
                     }
@@ -378,10 +759,18 @@ Solucao Algoritmos::construirGulosoRandomizado(double alpha) const {
             int idx = Randomizador::randInt(0, tamanhoLRC - 1);
             const Candidato& escolhido = candidatos[idx];
             
-            solucao.setPai(escolhido.vertice, escolhido.pai);
-            conectados[escolhido.vertice] = true;
-            numConectados++;
-            atualizarCacheDemanda(solucao, escolhido.vertice, escolhido.pai);
+            conectar(escolhido.vertice, escolhido.pai, escolhido.custo);
+        }
+        
+        if (abandonar) {
+            double limite = limiteConclusao();
+            if (limite > limiteAbandono) {
+                if (limiteInferior != nullptr) {
+                    *limiteInferior = limite;
+                }
+                solucao.calcularCusto();
+                return solucao;
+            }
         }
     }
     
@@ -391,196 +780,1169 @@ Solucao Algoritmos::construirGulosoRandomizado(double alpha) const {
     return solucao;
 }
 
-// Executa algoritmo guloso
-Solucao Algoritmos::executarGuloso(ResultadoExecucao& resultado, bool verbose) {
-    Cronometro crono;
-    crono.iniciar();
+// MST (Prim O(k²)) do subconjunto de vértices mais a raiz
+double Algoritmos::arvoreMinimaSubconjunto(const std::vector<int>& vertices, std::vector<int>* pais) const {
+    int raiz = grafo->getRaiz();
+    int k = vertices.size();
     
-    Solucao melhorSolucao = construirGuloso();
+    // Posição 0 = raiz, posições 1..k = vértices do subconjunto
+    std::vector<double> distancia(k + 1, INFINITO);
+    std::vector<int> paiLocal(k + 1, -1);
+    std::vector<bool> naArvore(k + 1, false);
     
-    crono.parar();
+    naArvore[0] = true;
+    for (int i = 1; i <= k; i++) {
+        if (grafo->existeAresta(vertices[i - 1], raiz)) {
+            distancia[i] = grafo->getCusto(vertices[i - 1], raiz);
+            paiLocal[i] = 0;
+        }
+    }
     
-    // Preencher resultado
-    resultado.dataHora = Utils::getDataHoraAtual();
-    resultado.instancia = grafo->getNomeInstancia();
-    resultado.numVertices = grafo->getNumVertices();
-    resultado.capacidade = grafo->getCapacidade();
-    resultado.algoritmo = "guloso";
-    resultado.alpha = -1;
-    resultado.iteracoes = -1;
-    resultado.tamanhoBloco = -1;
-    resultado.semente = Randomizador::getSemente();
-    resultado.tempoSegundos = crono.getTempoSegundos();
-    resultado.melhorSolucao = melhorSolucao.getCustoTotal();
-    resultado.mediaSolucoes = -1;
-    resultado.melhorAlpha = -1;
-    resultado.solucaoOtima = grafo->getSolucaoOtima();
+    double custo = 0;
+    for (int passo = 0; passo < k; passo++) {
+        // Vértice mais barato ainda fora da árvore
+        int escolhido = -1;
+        for (int i = 1; i <= k; i++) {
+            if (!naArvore[i] && (escolhido == -1 || distancia[i] < distancia[escolhido])) {
+                escolhido = i;
+            }
+        }
+        if (escolhido == -1 || distancia[escolhido] == INFINITO) {
+            return INFINITO;  // Subconjunto não alcança a raiz
+        }
+        
+        naArvore[escolhido] = true;
+        custo += distancia[escolhido];
+        
+        // Relaxar arestas a partir do vértice escolhido
+        int v = vertices[escolhido - 1];
+        for (int i = 1; i <= k; i++) {
+            if (naArvore[i]) continue;
+            int u = vertices[i - 1];
+            if (!grafo->existeAresta(u, v)) continue;
+            double c = grafo->getCusto(u, v);
+            if (c < distancia[i]) {
+                distancia[i] = c;
+                paiLocal[i] = escolhido;
+            }
+        }
+    }
     
-    return melhorSolucao;
+    if (pais != nullptr) {
+        pais->resize(k);
+        for (int i = 1; i <= k; i++) {
+            (*pais)[i - 1] = (paiLocal[i] == 0) ? raiz : vertices[paiLocal[i] - 1];
+        }
+    }
+    
+    return custo;
 }
 
-// Executa algoritmo guloso randomizado
-Solucao Algoritmos::executarGulosoRandomizado(double alpha, int numIteracoes, ResultadoExecucao& resultado, bool verbose) {
-    Cronometro crono;
-    crono.iniciar();
+// Re-otimiza as arestas internas de cada subárvore da raiz
+double Algoritmos::otimizarSubarvoresMST(Solucao& solucao) const {
+    if (!solucao.estaCompleta()) {
+        return 0;
+    }
     
-    Solucao melhorSolucao(grafo);
-    double melhorCusto = INFINITO;
-
-    // Solucao melhorSolucao = construirGuloso();
-    // double melhorCusto = melhorSolucao.getCustoTotal();
-
-    double somaCustos = 0;
+    int n = grafo->getNumVertices();
+    double custoAntes = solucao.calcularCusto();
+    solucao.verificarViabilidade();  // Garante IDs de subárvore atualizados
     
-    for (int iter = 0; iter < numIteracoes; iter++) {
-        Solucao solucaoAtual = construirGulosoRandomizado(alpha);
-        double custoAtual = solucaoAtual.getCustoTotal();
-        
-        if (verbose) {
-            std::cout << "\nIter: " << iter << std::endl;
-            std::cout << "Custo total: " << custoAtual << std::endl;
-            std::cout << "Melhor custo: " << melhorCusto << std::endl;
-            std::cout << "Viabilidade: " << solucaoAtual.isValida() << std::endl;   
+    // Agrupar vértices por subárvore em uma única passada O(n)
+    int numSub = solucao.getNumSubarvores();
+    std::vector<std::vector<int>> grupos(numSub);
+    for (int i = 0; i < n; i++) {
+        int s = solucao.getSubarvore(i);
+        if (s > 0 && s <= numSub) {
+            grupos[s - 1].push_back(i);
         }
-
-        somaCustos += custoAtual;
-        
-        if (custoAtual < melhorCusto && solucaoAtual.isValida()) {
-            melhorCusto = custoAtual;
-            melhorSolucao = solucaoAtual;
+    }
+    
+    // Cada subárvore é independente: resolver em paralelo
+    std::vector<std::vector<int>> novosPais(numSub);
+    std::vector<bool> melhorou(numSub, false);
+    
+    #pragma omp parallel for schedule(dynamic) if (n >= 64)
+    for (int g = 0; g < numSub; g++) {
+        double custoAtual = 0;
+        for (int v : grupos[g]) {
+            custoAtual += grafo->getCusto(v, solucao.getPai(v));
         }
+        
+        double custoMST = arvoreMinimaSubconjunto(grupos[g], &novosPais[g]);
+        melhorou[g] = custoMST < custoAtual - 1e-9;
     }
     
-    crono.parar();
+    // Aplicar sequencialmente apenas as subárvores que melhoraram
+    for (int g = 0; g < numSub; g++) {
+        if (!melhorou[g]) continue;
+        for (size_t i = 0; i < grupos[g].size(); i++) {
+            solucao.setPai(grupos[g][i], novosPais[g][i]);
+        }
+    }
     
-    // Preencher resultado
-    resultado.dataHora = Utils::getDataHoraAtual();
-    resultado.instancia = grafo->getNomeInstancia();
-    resultado.numVertices = grafo->getNumVertices();
-    resultado.capacidade = grafo->getCapacidade();
-    resultado.algoritmo = "randomizado";
-    resultado.alpha = alpha;
-    resultado.iteracoes = numIteracoes;
-    resultado.tamanhoBloco = -1;
-    resultado.semente = Randomizador::getSemente();
-    resultado.tempoSegundos = crono.getTempoSegundos();
-    resultado.melhorSolucao = melhorCusto;
-    resultado.mediaSolucoes = somaCustos / numIteracoes;
-    resultado.melhorAlpha = -1;
-    resultado.solucaoOtima = grafo->getSolucaoOtima();
+    double custoDepois = solucao.calcularCusto();
+    solucao.verificarViabilidade();
     
-    return melhorSolucao;
+    return custoAntes - custoDepois;
 }
 
-// Executa algoritmo guloso randomizado reativo
-Solucao Algoritmos::executarGulosoReativo(const std::vector<double>& alphas, int numIteracoes, int tamanhoBloco, ResultadoExecucao& resultado, bool verbose) {
-    Cronometro crono;
-    crono.iniciar();
-    
-    int numAlphas = alphas.size();
-    if (numAlphas == 0) {
-        resultado.melhorSolucao = INFINITO;
-        return Solucao(grafo);
+// Vizinhança de troca cíclica (Ahuja-Orlin-Sharma)
+namespace {
+    const int MAX_RODADAS_TROCA = 100;    // Trocas aplicadas por chamada
+    const int MAX_COMPRIMENTO_CICLO = 6;  // Subárvores envolvidas em um ciclo ou caminho
+    const double EPSILON_TROCA = 1e-9;
+
+    // Melhor ciclo ou caminho encontrado a partir de um nó do grafo de melhoria
+    struct TrocaCiclica {
+        double ganho = 0;          // Variação de custo (< 0 = melhora)
+        std::vector<int> nos;      // Nós na ordem: nos[i] entra na subárvore de nos[i + 1]
+        int grupoFinal = -1;       // Caminho: subárvore que recebe o último nó (-1 = ciclo)
+    };
+}
+
+// Busca e aplica ciclos e caminhos de troca de custo negativo entre subárvores
+double Algoritmos::trocaCiclica(Solucao& solucao) const {
+    if (!solucao.estaCompleta() || !solucao.verificarViabilidade()) {
+        return 0;
     }
+    otimizarSubarvoresMST(solucao);  // O custo de cada subárvore passa a ser o da sua MST
+    double custoInicial = solucao.getCustoTotal();
     
-    // Inicializar probabilidades uniformes
-    std::vector<double> probabilidades(numAlphas, 1.0 / numAlphas);
-    
-    // Estatísticas por alpha
-    std::vector<double> somaQualidade(numAlphas, 0);
-    std::vector<int> contadorUso(numAlphas, 0);
-    std::vector<double> melhorPorAlpha(numAlphas, INFINITO);
-    
-    Solucao melhorSolucaoGlobal(grafo);
-    double melhorCustoGlobal = INFINITO;
-    int melhorAlphaIdx = 0;
-    double somaCustos = 0;
-    double FATOR_AMPLIFICACAO = 3;
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+    int capacidade = grafo->getCapacidade();
     
-    for (int iter = 0; iter < numIteracoes; iter++) {
-        // Selecionar alpha baseado nas probabilidades
-        double r = Randomizador::randDouble();
-        double acumulado = 0;
-        int alphaIdx = 0;
+    for (int rodada = 0; rodada < MAX_RODADAS_TROCA; rodada++) {
+        solucao.verificarViabilidade();
         
-        for (int i = 0; i < numAlphas; i++) {
-            acumulado += probabilidades[i];
-            if (r <= acumulado) {
-                alphaIdx = i;
-                break;
-            }
+        // Subárvores da raiz: vértices, custo e demanda
+        int m = solucao.getNumSubarvores();
+        std::vector<std::vector<int>> grupos(m);
+        std::vector<double> custoGrupo(m, 0);
+        std::vector<std::vector<int>> filhos(n);
+        for (int v = 0; v < n; v++) {
+            if (v == raiz) continue;
+            int g = solucao.getSubarvore(v) - 1;
+            grupos[g].push_back(v);
+            custoGrupo[g] += grafo->getCusto(v, solucao.getPai(v));
+            filhos[solucao.getPai(v)].push_back(v);
         }
         
-        // Construir solução com o alpha selecionado
-        Solucao solucaoAtual = construirGulosoRandomizado(alphas[alphaIdx]);
-        double custoAtual = solucaoAtual.getCustoTotal();
-        somaCustos += custoAtual;
-        
-        // Atualizar estatísticas
-        contadorUso[alphaIdx]++;
-        
-        if (custoAtual < melhorPorAlpha[alphaIdx]) {
-            melhorPorAlpha[alphaIdx] = custoAtual;
+        // Nós do grafo de melhoria: cada vértice sozinho e cada vértice com os seus
+        // descendentes (se tiver algum), sempre dentro de uma subárvore da raiz
+        std::vector<std::vector<int>> conjunto;
+        std::vector<int> grupoNo;
+        std::vector<int> demandaNo;
+        for (int v = 0; v < n; v++) {
+            if (v == raiz) continue;
+            conjunto.push_back({v});
+            if (!filhos[v].empty()) {
+                std::vector<int> descendentes = {v};
+                for (size_t i = 0; i < descendentes.size(); i++) {
+                    for (int f : filhos[descendentes[i]]) descendentes.push_back(f);
+                }
+                conjunto.push_back(descendentes);
+            }
         }
-        
-        if (custoAtual < melhorCustoGlobal && solucaoAtual.isValida()) {
-            melhorCustoGlobal = custoAtual;
-            melhorSolucaoGlobal = solucaoAtual;
-            melhorAlphaIdx = alphaIdx;
+        int numNos = conjunto.size();
+        grupoNo.resize(numNos);
+        demandaNo.resize(numNos);
+        for (int x = 0; x < numNos; x++) {
+            grupoNo[x] = solucao.getSubarvore(conjunto[x][0]) - 1;
+            demandaNo[x] = 0;
+            for (int v : conjunto[x]) demandaNo[x] += grafo->getDemanda(v);
         }
         
-        // Atualizar probabilidades a cada bloco
-        if ((iter + 1) % tamanhoBloco == 0 && iter > 0) {
-
-            if (verbose) {
-                std::cout << "\nIter: " << iter << std::endl;
-
-                for(int i = 0; i < numAlphas; i++) {
-                    std::cout << "Alpha: " << alphas[i] << " - Probabilidade: " << probabilidades[i] << std::endl;
+        // MST da subárvore g sem os vértices do nó y (-1 = nenhum) e com os do nó x (-1 = nenhum)
+        auto custoTroca = [&](int g, int y, int x) {
+            std::vector<int> vertices;
+            for (int v : grupos[g]) {
+                if (y < 0 || std::find(conjunto[y].begin(), conjunto[y].end(), v) == conjunto[y].end()) {
+                    vertices.push_back(v);
                 }
             }
-
-            // Calcular qualidade de cada alpha
-            std::vector<double> qualidade(numAlphas, 0);
-            double somaQualidades = 0;
-            
-            for (int i = 0; i < numAlphas; i++) {
-                if (contadorUso[i] > 0 && melhorPorAlpha[i] < INFINITO) {
-                    // Qualidade = melhor global / melhor do alpha
-                    // Quanto menor o custo, maior a qualidade
-                    qualidade[i] = melhorCustoGlobal / melhorPorAlpha[i];
-                    qualidade[i] = std::pow(qualidade[i], FATOR_AMPLIFICACAO);  // Elevar ao quadrado para amplificar
-                } else {
-                    qualidade[i] = 0.1;  // Valor mínimo para alphas não usados
-                }
-                somaQualidades += qualidade[i];
+            if (x >= 0) {
+                vertices.insert(vertices.end(), conjunto[x].begin(), conjunto[x].end());
             }
-
-            if (verbose) {
-                for(int i = 0; i < numAlphas; i++) {
-                    std::cout << "Alpha: " << alphas[i] << " - Qualidade: " << qualidade[i] << std::endl;
-                }
-
-                for(int i = 0; i < numAlphas; i++) {
-                    std::cout << "Alpha: " << alphas[i] << " - Melhor por Alpha: " << melhorPorAlpha[i] << std::endl;
-                }
-
-                std::cout << "Soma Qualidades: " << somaQualidades << std::endl;
+            return (g < m ? arvoreMinimaSubconjunto(vertices) - custoGrupo[g] : arvoreMinimaSubconjunto(vertices));
+        };
+        
+        // Grafo de melhoria (em paralelo por nó de destino): arco x -> y = x entra na
+        // subárvore de y e y sai dela; saída[y] = y sai sem reposição; entrada[x][g] = x
+        // entra na subárvore g (g = m: nova subárvore) sem que ninguém saia
+        std::vector<double> arco((size_t)numNos * numNos, INFINITO);
+        std::vector<double> saida(numNos, INFINITO);
+        std::vector<double> entrada((size_t)numNos * (m + 1), INFINITO);
+        std::vector<int> demandaGrupo(m + 1, 0);
+        for (int g = 0; g < m; g++) demandaGrupo[g] = solucao.getDemandaSubarvore(g + 1);
+        grupos.emplace_back();  // Nova subárvore (vazia)
+        
+        #pragma omp parallel for schedule(dynamic) if (numNos >= 64)
+        for (int y = 0; y < numNos; y++) {
+            int g = grupoNo[y];
+            saida[y] = custoTroca(g, y, -1);
+            for (int x = 0; x < numNos; x++) {
+                if (grupoNo[x] == g || demandaGrupo[g] - demandaNo[y] + demandaNo[x] > capacidade) continue;
+                arco[(size_t)x * numNos + y] = custoTroca(g, y, x);
+            }
+            for (int h = 0; h <= m; h++) {
+                if (h == g || demandaGrupo[h] + demandaNo[y] > capacidade) continue;
+                entrada[(size_t)y * (m + 1) + h] = custoTroca(h, -1, y);
             }
+        }
+        
+        // Busca de rótulos a partir de cada nó: caminhos que não repetem subárvores,
+        // fechados em ciclo (volta ao nó inicial) ou em caminho (último nó entra numa
+        // subárvore ainda não usada, e o nó inicial sai sem reposição)
+        std::vector<TrocaCiclica> melhorPorInicio(numNos);
+        #pragma omp parallel for schedule(dynamic) if (numNos >= 64)
+        for (int s = 0; s < numNos; s++) {
+            std::vector<double> distancia(numNos, INFINITO);
+            std::vector<int> predecessor(numNos, -1);
+            std::vector<char> naFila(numNos, 0);
+            std::vector<int> fila;
+            std::vector<int> caminho;
+            std::vector<char> grupoUsado(m + 1, 0);
+            TrocaCiclica& melhor = melhorPorInicio[s];
             
-            // Normalizar para obter probabilidades
-            if (somaQualidades > 0) {
-                for (int i = 0; i < numAlphas; i++) {
-                    probabilidades[i] = qualidade[i] / somaQualidades;
+            // Reconstrói o caminho s -> ... -> u; falso se os predecessores mudaram no meio
+            auto montarCaminho = [&](int u) {
+                caminho.clear();
+                for (int v = u; v != -1 && (int)caminho.size() <= MAX_COMPRIMENTO_CICLO; v = predecessor[v]) {
+                    caminho.push_back(v);
+                    if (v == s) break;
                 }
-            }
-
-            if (verbose) {
-                for(int i = 0; i < numAlphas; i++) {
-                    std::cout << "Alpha: " << alphas[i] << " - Nova probabilidade: " << probabilidades[i] << std::endl;
+                if (caminho.back() != s) return false;
+                std::reverse(caminho.begin(), caminho.end());
+                for (int v : caminho) {
+                    if (grupoUsado[grupoNo[v]]) {
+                        for (int w : caminho) grupoUsado[grupoNo[w]] = 0;
+                        return false;
+                    }
+                    grupoUsado[grupoNo[v]] = 1;
                 }
-            }
+                return true;
+            };
+            
+            distancia[s] = 0;
+            fila.push_back(s);
+            naFila[s] = 1;
+            for (size_t cabeca = 0; cabeca < fila.size(); cabeca++) {
+                int u = fila[cabeca];
+                naFila[u] = 0;
+                if (!montarCaminho(u)) continue;
+                
+                // Custo exato do caminho atual (os rótulos podem estar desatualizados)
+                double custoCaminho = 0;
+                for (size_t i = 0; i + 1 < caminho.size(); i++) {
+                    custoCaminho += arco[(size_t)caminho[i] * numNos + caminho[i + 1]];
+                }
+                
+                // Fechamento em ciclo: u entra na subárvore de s, de onde s sai
+                if (u != s) {
+                    double total = custoCaminho + arco[(size_t)u * numNos + s];
+                    if (total < melhor.ganho - EPSILON_TROCA) {
+                        melhor.ganho = total;
+                        melhor.nos = caminho;
+                        melhor.grupoFinal = -1;
+                    }
+                }
+                // Fechamento em caminho: s sai sem reposição e u entra numa subárvore livre
+                for (int h = 0; h <= m; h++) {
+                    if (h < m && grupoUsado[h]) continue;
+                    double total = saida[s] + custoCaminho + entrada[(size_t)u * (m + 1) + h];
+                    if (total < melhor.ganho - EPSILON_TROCA) {
+                        melhor.ganho = total;
+                        melhor.nos = caminho;
+                        melhor.grupoFinal = h;
+                    }
+                }
+                
+                // Estender o caminho para nós de subárvores ainda não usadas
+                if ((int)caminho.size() < MAX_COMPRIMENTO_CICLO) {
+                    for (int v = 0; v < numNos; v++) {
+                        if (grupoUsado[grupoNo[v]]) continue;
+                        double c = arco[(size_t)u * numNos + v];
+                        double novo = custoCaminho + c;
+                        // Ganho parcial: todo ciclo negativo tem uma rotação com todas as
+                        // somas parciais negativas (no caminho, contando a saída de s)
+                        if (c >= INFINITO || (novo >= 0 && saida[s] + novo >= 0)) continue;
+                        if (novo >= distancia[v] - EPSILON_TROCA) continue;
+                        distancia[v] = novo;
+                        predecessor[v] = u;
+                        if (!naFila[v]) {
+                            naFila[v] = 1;
+                            fila.push_back(v);
+                        }
+                    }
+                }
+                for (int v : caminho) grupoUsado[grupoNo[v]] = 0;
+            }
+        }
+        
+        // Aplicar a melhor troca encontrada (menor índice de início no empate)
+        int melhorInicio = -1;
+        for (int s = 0; s < numNos; s++) {
+            if (melhorPorInicio[s].ganho < -EPSILON_TROCA &&
+                (melhorInicio < 0 || melhorPorInicio[s].ganho < melhorPorInicio[melhorInicio].ganho)) {
+                melhorInicio = s;
+            }
+        }
+        if (melhorInicio < 0) {
+            break;
+        }
+        const TrocaCiclica& troca = melhorPorInicio[melhorInicio];
+        
+        // Novos conjuntos das subárvores afetadas: cada nó entra na subárvore do seguinte
+        std::map<int, std::vector<int>> novos;
+        int k = troca.nos.size();
+        for (int i = 0; i < k; i++) {
+            int x = troca.nos[i];
+            int destino;
+            if (i + 1 < k) {
+                destino = grupoNo[troca.nos[i + 1]];
+            } else {
+                destino = troca.grupoFinal >= 0 ? troca.grupoFinal : grupoNo[troca.nos[0]];
+            }
+            std::vector<int>& conjuntoDestino = novos[destino];
+            conjuntoDestino.insert(conjuntoDestino.end(), conjunto[x].begin(), conjunto[x].end());
+        }
+        std::vector<bool> sai(n, false);
+        for (int x : troca.nos) {
+            for (int v : conjunto[x]) sai[v] = true;
+        }
+        for (auto& par : novos) {
+            for (int v : grupos[par.first]) {
+                if (!sai[v]) par.second.push_back(v);
+            }
+        }
+        if (troca.grupoFinal >= 0) {
+            // A subárvore de origem do caminho também muda (perde o nó inicial)
+            int origem = grupoNo[troca.nos[0]];
+            std::vector<int>& restantes = novos[origem];
+            for (int v : grupos[origem]) {
+                if (!sai[v]) restantes.push_back(v);
+            }
+        }
+        
+        // Religar cada subárvore afetada pela sua MST
+        for (const auto& par : novos) {
+            if (par.second.empty()) continue;
+            std::vector<int> pais;
+            arvoreMinimaSubconjunto(par.second, &pais);
+            for (size_t i = 0; i < par.second.size(); i++) {
+                solucao.setPai(par.second[i], pais[i]);
+            }
+        }
+        solucao.calcularCusto();
+    }
+    
+    solucao.verificarViabilidade();
+    return custoInicial - solucao.getCustoTotal();
+}
+
+// Define a solução de partida (warm start)
+void Algoritmos::setSolucaoInicial(const std::vector<int>& pais) {
+    paisIniciais = pais;
+}
+
+// Define o controle externo (cancelamento e progresso)
+void Algoritmos::setControle(const ControleExecucao* c) {
+    controle = c;
+}
+
+// Verifica se o cancelamento foi pedido
+bool Algoritmos::cancelado() const {
+    return controle != nullptr && controle->isCancelado();
+}
+
+// Escolhe o motor construtivo
+bool Algoritmos::setConstrutor(const std::string& nome) {
+    if (nome != "prim" && nome != "kruskal") {
+        return false;
+    }
+    construtor = nome;
+    return true;
+}
+
+// Escolhe a política de seleção de alpha do reativo
+bool Algoritmos::setPoliticaAlpha(const std::string& nome, double largura) {
+    if (nome != "roleta" && nome != "ucb1" && nome != "thompson") {
+        return false;
+    }
+    politicaAlpha = nome;
+    larguraAlpha = std::max(0.0, largura);
+    return true;
+}
+
+// Liga ou desliga o abandono de construções pelo limite inferior
+void Algoritmos::setAbandono(bool ativo) {
+    abandono = ativo;
+}
+
+// Liga ou desliga a troca cíclica no pós-processamento
+void Algoritmos::setTrocaCiclica(bool ativa) {
+    usarTrocaCiclica = ativa;
+}
+
+// Liga a recombinação do pool de subárvores
+void Algoritmos::setRecombinacao(int intervalo) {
+    intervaloRecombinacao = std::max(0, intervalo);
+}
+
+// Define o trace de convergência
+void Algoritmos::setTrace(RegistroTrace* t) {
+    trace = t;
+}
+
+// Configura checkpoints da busca reativa
+void Algoritmos::configurarCheckpoint(const std::string& arquivo, int intervalo, bool retomar) {
+    arquivoCheckpoint = arquivo;
+    intervaloCheckpoint = std::max(1, intervalo);
+    retomarCheckpoint = retomar;
+}
+
+bool Algoritmos::isCheckpointRecusado() const {
+    return checkpointRecusado;
+}
+
+// Monta a solução de partida a partir do vetor de pais
+bool Algoritmos::obterSolucaoInicial(Solucao& solucao) const {
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+    if ((int)paisIniciais.size() != n) {
+        return false;
+    }
+    
+    Solucao inicial(grafo);
+    for (int v = 0; v < n; v++) {
+        if (v != raiz) {
+            inicial.setPai(v, paisIniciais[v]);
+        }
+    }
+    inicial.calcularCusto();
+    if (!inicial.estaCompleta() || !inicial.verificarViabilidade()) {
+        return false;
+    }
+    
+    solucao = inicial;
+    return true;
+}
+
+// Pós-processamento aplicado à solução retornada por cada executar*
+void Algoritmos::posProcessar(Solucao& solucao, bool verbose) const {
+    double ganho = otimizarSubarvoresMST(solucao);
+    
+    if (verbose && ganho > 0) {
+        std::cout << "Re-otimização MST das subárvores: -" << ganho << std::endl;
+    }
+    
+    if (usarTrocaCiclica) {
+        double ganhoTroca = trocaCiclica(solucao);
+        if (verbose && ganhoTroca > 0) {
+            std::cout << "Troca cíclica entre subárvores: -" << ganhoTroca << std::endl;
+        }
+    }
+}
+
+namespace {
+    const long MAX_NOS_RECOMBINACAO = 200000;  // Nós do branch-and-bound por recombinação
+}
+
+// Particionamento sobre o pool; a partição só substitui a incumbente se for melhor
+bool Algoritmos::recombinarPool(PoolSubarvores& pool, Solucao& incumbente, double& custoIncumbente, bool verbose) const {
+    if (pool.getNovasDesdeRecombinacao() == 0) {
+        return false;
+    }
+    // As colunas têm custo de MST: a referência é a incumbente com as subárvores re-otimizadas
+    double referencia = custoIncumbente;
+    if (incumbente.isValida()) {
+        Solucao otimizada = incumbente;
+        referencia -= otimizarSubarvoresMST(otimizada);
+    }
+    Solucao combinada(grafo);
+    if (!pool.recombinar(referencia, combinada, MAX_NOS_RECOMBINACAO)) {
+        return false;
+    }
+    if (verbose) {
+        std::cout << "Recombinação do pool (" << pool.tamanho() << " subárvores): "
+                  << custoIncumbente << " -> " << combinada.getCustoTotal() << std::endl;
+    }
+    incumbente = combinada;
+    custoIncumbente = combinada.getCustoTotal();
+    return true;
+}
+
+// Remove parte da solução (ruína) para a reconstrução do LNS
+Solucao Algoritmos::destruirParcialmente(const Solucao& solucao, int numRemover) const {
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+    
+    std::vector<bool> remover(n, false);
+    int estrategia = Randomizador::randInt(0, 2);
+    
+    if (estrategia == 0) {
+        // Subárvores inteiras da raiz, sorteadas até atingir o tamanho desejado
+        std::vector<int> filhosRaiz;
+        for (int v = 0; v < n; v++) {
+            if (v != raiz && solucao.getPai(v) == raiz) {
+                filhosRaiz.push_back(v);
+            }
+        }
+        std::shuffle(filhosRaiz.begin(), filhosRaiz.end(), Randomizador::getGerador());
+        
+        int removidos = 0;
+        for (size_t i = 0; i < filhosRaiz.size() && removidos < numRemover; i++) {
+            int subId = solucao.getSubarvore(filhosRaiz[i]);
+            for (int v = 0; v < n; v++) {
+                if (solucao.getSubarvore(v) == subId) {
+                    remover[v] = true;
+                    removidos++;
+                }
+            }
+        }
+    } else if (estrategia == 1) {
+        // Agrupamento geográfico: um vértice semente e seus vizinhos mais próximos
+        int semente = Randomizador::randInt(0, n - 1);
+        if (semente == raiz) semente = (semente + 1) % n;
+        remover[semente] = true;
+        
+        int removidos = 1;
+        for (int v : grafo->getVizinhosOrdenados(semente)) {
+            if (removidos >= numRemover) break;
+            if (v != raiz && !remover[v]) {
+                remover[v] = true;
+                removidos++;
+            }
+        }
+    } else {
+        // Subconjunto aleatório
+        std::vector<int> vertices;
+        for (int v = 0; v < n; v++) {
+            if (v != raiz) vertices.push_back(v);
+        }
+        std::shuffle(vertices.begin(), vertices.end(), Randomizador::getGerador());
+        for (int i = 0; i < numRemover && i < (int)vertices.size(); i++) {
+            remover[vertices[i]] = true;
+        }
+    }
+    
+    return desconectar(solucao, remover);
+}
+
+// Desconecta os vértices marcados e todos os seus descendentes
+Solucao Algoritmos::desconectar(const Solucao& solucao, const std::vector<bool>& remover) const {
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+    
+    // Fechamento: descendentes de vértices removidos também são desconectados,
+    // para que a solução parcial continue sendo uma floresta presa à raiz
+    // estado: 0 = desconhecido, 1 = mantido, 2 = removido
+    std::vector<int> estado(n, 0);
+    estado[raiz] = 1;
+    std::vector<int> caminho;
+    
+    for (int v = 0; v < n; v++) {
+        caminho.clear();
+        int atual = v;
+        while (atual != -1 && estado[atual] == 0 && !remover[atual]) {
+            caminho.push_back(atual);
+            atual = solucao.getPai(atual);
+        }
+        
+        int resultadoCaminho = (atual != -1 && estado[atual] == 1) ? 1 : 2;
+        if (atual != -1 && estado[atual] == 0) {
+            estado[atual] = 2;  // atual está marcado para remoção
+        }
+        for (int u : caminho) {
+            estado[u] = resultadoCaminho;
+        }
+    }
+    
+    Solucao parcial(solucao);
+    for (int v = 0; v < n; v++) {
+        if (estado[v] == 2) {
+            parcial.setPai(v, -1);
+        }
+    }
+    
+    return parcial;
+}
+
+// Adapta uma solução de outra capacidade ao Q atual
+Solucao Algoritmos::adaptarCapacidade(const Solucao& anterior) const {
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+    int capacidade = grafo->getCapacidade();
+    
+    std::vector<int> pai = anterior.getVetorPais();
+    
+    // Filhos de cada vértice na árvore anterior
+    std::vector<std::vector<int>> filhos(n);
+    for (int v = 0; v < n; v++) {
+        if (v != raiz && pai[v] >= 0) {
+            filhos[pai[v]].push_back(v);
+        }
+    }
+    
+    // Divisão (Q diminuiu): em cada subárvore da raiz, mantém os vértices visitados em
+    // largura enquanto couberem em Q; os demais (e seus descendentes) são reinseridos
+    std::vector<bool> remover(n, false);
+    std::vector<int> fila;
+    for (int topo : filhos[raiz]) {
+        int demanda = 0;
+        fila.assign(1, topo);
+        for (size_t i = 0; i < fila.size(); i++) {
+            int v = fila[i];
+            if (demanda + grafo->getDemanda(v) > capacidade && v != topo) {
+                remover[v] = true;
+                continue;
+            }
+            demanda += grafo->getDemanda(v);
+            for (int f : filhos[v]) {
+                fila.push_back(f);
+            }
+        }
+    }
+    
+    Solucao parcial = desconectar(anterior, remover);
+    Solucao solucao = completarGulosoRandomizado(parcial, 0.0);
+    pai = solucao.getVetorPais();
+    
+    // Fusão (Q aumentou): rodadas de Esau-Williams. A subárvore B é pendurada em um
+    // vértice a de outra subárvore A pela aresta (b, a); B é reenraizada em b, e a
+    // economia é o custo da ligação de B à raiz menos c(b, a)
+    struct Fusao {
+        double economia;
+        int b;
+        int a;
+    };
+    
+    while (solucao.estaCompleta()) {
+        // Topo (filho da raiz) de cada vértice e demanda de cada subárvore
+        std::vector<int> topo(n, -1);
+        std::vector<int> demandaTopo(n, 0);
+        for (int v = 0; v < n; v++) {
+            if (v == raiz || topo[v] >= 0) continue;
+            fila.clear();
+            int u = v;
+            while (pai[u] != raiz && topo[u] < 0) {
+                fila.push_back(u);
+                u = pai[u];
+            }
+            int t = (pai[u] == raiz) ? u : topo[u];
+            topo[u] = t;
+            for (int w : fila) {
+                topo[w] = t;
+            }
+        }
+        for (int v = 0; v < n; v++) {
+            if (v != raiz) demandaTopo[topo[v]] += grafo->getDemanda(v);
+        }
+        
+        // Melhor fusão de cada subárvore B
+        std::vector<Fusao> fusoes;
+        for (int b = 0; b < n; b++) {
+            if (b == raiz) continue;
+            int tb = topo[b];
+            double custoRaiz = grafo->getCusto(tb, raiz);
+            if (grafo->isEsparsa()) {
+                // Instância esparsa: só as arestas de b, O(grau)
+                Vizinhanca vizinhos = grafo->getVizinhos(b);
+                for (int k = 0; k < vizinhos.grau; k++) {
+                    int a = vizinhos.vertices[k];
+                    if (a == raiz || topo[a] == tb) continue;
+                    if (demandaTopo[tb] + demandaTopo[topo[a]] > capacidade) continue;
+                    double economia = custoRaiz - vizinhos.custos[k];
+                    if (economia > 1e-9) {
+                        fusoes.push_back({economia, b, a});
+                    }
+                }
+            } else {
+                for (int a = 0; a < n; a++) {
+                    if (a == raiz || topo[a] == tb || !grafo->existeAresta(b, a)) continue;
+                    if (demandaTopo[tb] + demandaTopo[topo[a]] > capacidade) continue;
+                    double economia = custoRaiz - grafo->getCusto(b, a);
+                    if (economia > 1e-9) {
+                        fusoes.push_back({economia, b, a});
+                    }
+                }
+            }
+        }
+        if (fusoes.empty()) break;
+        
+        std::sort(fusoes.begin(), fusoes.end(), [](const Fusao& x, const Fusao& y) {
+            if (x.economia != y.economia) return x.economia > y.economia;
+            if (x.b != y.b) return x.b < y.b;
+            return x.a < y.a;
+        });
+        
+        // Aplicar fusões que não envolvem subárvores já alteradas nesta rodada
+        std::vector<bool> alterada(n, false);
+        for (const Fusao& f : fusoes) {
+            int tb = topo[f.b];
+            int ta = topo[f.a];
+            if (alterada[tb] || alterada[ta]) continue;
+            alterada[tb] = alterada[ta] = true;
+            
+            // Reenraizar B em b invertendo o caminho b -> topo
+            int anteriorV = f.a;
+            int v = f.b;
+            while (v != raiz) {
+                int proximo = pai[v];
+                pai[v] = anteriorV;
+                anteriorV = v;
+                v = proximo;
+            }
+        }
+    }
+    
+    Solucao fundida(grafo);
+    for (int v = 0; v < n; v++) {
+        if (v != raiz) {
+            fundida.setPai(v, pai[v]);
+        }
+    }
+    fundida.calcularCusto();
+    fundida.verificarViabilidade();
+    otimizarSubarvoresMST(fundida);
+    
+    return fundida;
+}
+
+// Executa algoritmo guloso
+Solucao Algoritmos::executarGuloso(ResultadoExecucao& resultado, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+    
+    Solucao melhorSolucao = construirGuloso();
+    
+    Solucao inicial(grafo);
+    if (obterSolucaoInicial(inicial) &&
+        (!melhorSolucao.isValida() || inicial.getCustoTotal() < melhorSolucao.getCustoTotal())) {
+        melhorSolucao = inicial;
+    }
+    posProcessar(melhorSolucao, verbose);
+    
+    crono.parar();
+    
+    // Preencher resultado
+    resultado.dataHora = Utils::getDataHoraAtual();
+    resultado.instancia = grafo->getNomeInstancia();
+    resultado.numVertices = grafo->getNumVertices();
+    resultado.capacidade = grafo->getCapacidade();
+    resultado.algoritmo = "guloso";
+    resultado.construtor = construtor;
+    resultado.alpha = -1;
+    resultado.iteracoes = -1;
+    resultado.tamanhoBloco = -1;
+    resultado.semente = Randomizador::getSemente();
+    resultado.tempoSegundos = crono.getTempoSegundos();
+    resultado.melhorSolucao = melhorSolucao.getCustoTotal();
+    resultado.mediaSolucoes = -1;
+    resultado.melhorAlpha = -1;
+    resultado.solucaoOtima = grafo->getSolucaoOtima();
+    
+    return melhorSolucao;
+}
+
+// Executa algoritmo guloso randomizado
+Solucao Algoritmos::executarGulosoRandomizado(double alpha, int numIteracoes, ResultadoExecucao& resultado, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+    
+    Solucao melhorSolucao(grafo);
+    double melhorCusto = INFINITO;
+    if (obterSolucaoInicial(melhorSolucao)) {
+        melhorCusto = melhorSolucao.getCustoTotal();
+    }
+
+    // Solucao melhorSolucao = construirGuloso();
+    // double melhorCusto = melhorSolucao.getCustoTotal();
+
+    double somaCustos = 0;
+    int iteracoesExecutadas = 0;
+    
+    int abandonadas = 0;
+    
+    std::unique_ptr<PoolSubarvores> pool;
+    if (intervaloRecombinacao > 0) {
+        pool.reset(new PoolSubarvores(grafo, this));
+        if (melhorSolucao.isValida()) {
+            pool->adicionar(melhorSolucao);
+        }
+    }
+    
+    for (int iter = 0; iter < numIteracoes && !cancelado(); iter++) {
+        // Abandona a construção que não pode superar a incumbente
+        double limiteInferior = -1;
+        Solucao solucaoAtual = construirGulosoRandomizado(alpha, abandono ? melhorCusto : INFINITO, &limiteInferior);
+        double custoAtual = solucaoAtual.getCustoTotal();
+        
+        if (verbose) {
+            std::cout << "\nIter: " << iter << std::endl;
+            if (limiteInferior >= 0) {
+                std::cout << "Abandonada: limite inferior " << limiteInferior << std::endl;
+            } else {
+                std::cout << "Custo total: " << custoAtual << std::endl;
+            }
+            std::cout << "Melhor custo: " << melhorCusto << std::endl;
+            std::cout << "Viabilidade: " << solucaoAtual.isValida() << std::endl;   
+        }
+
+        if (limiteInferior >= 0) {
+            abandonadas++;
+        } else {
+            somaCustos += custoAtual;
+        }
+        
+        if (limiteInferior < 0 && custoAtual < melhorCusto && solucaoAtual.isValida()) {
+            melhorCusto = custoAtual;
+            melhorSolucao = solucaoAtual;
+        }
+        
+        if (pool) {
+            pool->adicionar(solucaoAtual);
+            if ((iter + 1) % intervaloRecombinacao == 0) {
+                recombinarPool(*pool, melhorSolucao, melhorCusto, verbose);
+            }
+        }
+        
+        if (trace != nullptr) {
+            trace->registrar(iter, 0, limiteInferior >= 0 ? limiteInferior : custoAtual,
+                             limiteInferior < 0 && solucaoAtual.isValida(), limiteInferior >= 0, melhorCusto);
+        }
+        
+        iteracoesExecutadas = iter + 1;
+        if (controle != nullptr) {
+            controle->reportar(iteracoesExecutadas, numIteracoes, melhorCusto, crono.getTempoSegundos());
+        }
+    }
+    
+    if (pool) {
+        recombinarPool(*pool, melhorSolucao, melhorCusto, verbose);
+        pool->preencherResultado(resultado);
+    }
+    
+    if (melhorSolucao.isValida()) {
+        posProcessar(melhorSolucao, verbose);
+        melhorCusto = melhorSolucao.getCustoTotal();
+    }
+    
+    crono.parar();
+    
+    // Preencher resultado
+    resultado.dataHora = Utils::getDataHoraAtual();
+    resultado.instancia = grafo->getNomeInstancia();
+    resultado.numVertices = grafo->getNumVertices();
+    resultado.capacidade = grafo->getCapacidade();
+    resultado.algoritmo = "randomizado";
+    resultado.construtor = construtor;
+    resultado.alpha = alpha;
+    resultado.iteracoes = iteracoesExecutadas;
+    resultado.tamanhoBloco = -1;
+    resultado.semente = Randomizador::getSemente();
+    resultado.tempoSegundos = crono.getTempoSegundos();
+    resultado.melhorSolucao = melhorCusto;
+    resultado.mediaSolucoes = iteracoesExecutadas > abandonadas ? somaCustos / (iteracoesExecutadas - abandonadas) : -1;
+    resultado.taxaAbandono = (abandono && iteracoesExecutadas > 0) ? (double)abandonadas / iteracoesExecutadas : -1;
+    resultado.melhorAlpha = -1;
+    resultado.solucaoOtima = grafo->getSolucaoOtima();
+    
+    return melhorSolucao;
+}
+
+// Sorteio do alpha por roleta sobre as probabilidades
+int Algoritmos::sortearAlpha(const std::vector<double>& probabilidades) const {
+    double r = Randomizador::randDouble();
+    double acumulado = 0;
+    
+    for (int i = 0; i < (int)probabilidades.size(); i++) {
+        acumulado += probabilidades[i];
+        if (r <= acumulado) {
+            return i;
+        }
+    }
+    return 0;
+}
+
+// Escolha do braço segundo a política de seleção de alpha
+int Algoritmos::escolherBraco(const EstadoReativo& estado) const {
+    if (politicaAlpha == "roleta") {
+        return sortearAlpha(estado.probabilidades);
+    }
+    
+    int numBracos = estado.contadorUso.size();
+    int melhorBraco = 0;
+    double melhorValor = -INFINITO;
+    
+    if (politicaAlpha == "ucb1") {
+        // Cada braço é jogado uma vez antes de usar o limite de confiança
+        int total = 0;
+        for (int i = 0; i < numBracos; i++) {
+            if (estado.contadorUso[i] == 0) {
+                return i;
+            }
+            total += estado.contadorUso[i];
+        }
+        for (int i = 0; i < numBracos; i++) {
+            double n = estado.contadorUso[i];
+            double valor = estado.somaQualidade[i] / n + std::sqrt(2.0 * std::log((double)total) / n);
+            if (valor > melhorValor) {
+                melhorValor = valor;
+                melhorBraco = i;
+            }
+        }
+        return melhorBraco;
+    }
+    
+    // Thompson: Beta(1 + recompensas, 1 + fracassos), amostrada por duas gama
+    for (int i = 0; i < numBracos; i++) {
+        double sucessos = 1 + estado.somaQualidade[i];
+        double fracassos = 1 + estado.contadorUso[i] - estado.somaQualidade[i];
+        std::gamma_distribution<double> gamaA(sucessos, 1.0);
+        std::gamma_distribution<double> gamaB(fracassos, 1.0);
+        double x = gamaA(Randomizador::getGerador());
+        double y = gamaB(Randomizador::getGerador());
+        double valor = x / (x + y);
+        if (valor > melhorValor) {
+            melhorValor = valor;
+            melhorBraco = i;
+        }
+    }
+    return melhorBraco;
+}
+
+// Alpha do braço: o próprio valor ou um sorteio na faixa do braço
+double Algoritmos::alphaDoBraco(const std::vector<double>& alphas, int braco) const {
+    if (larguraAlpha <= 0) {
+        return alphas[braco];
+    }
+    double minimo = std::max(0.0, alphas[braco] - larguraAlpha / 2);
+    double maximo = std::min(1.0, alphas[braco] + larguraAlpha / 2);
+    return Randomizador::randDouble(minimo, maximo);
+}
+
+// Recompensa da iteração para os bandidos (ucb1/thompson)
+void Algoritmos::registrarRecompensa(EstadoReativo& estado, int braco, double custo, bool valida) const {
+    double recompensa = 0;
+    if (valida) {
+        estado.piorCusto = std::max(estado.piorCusto, custo);
+        if (custo < estado.melhorCustoGlobal || estado.piorCusto <= estado.melhorCustoGlobal) {
+            recompensa = 1;
+        } else {
+            recompensa = (estado.piorCusto - custo) / (estado.piorCusto - estado.melhorCustoGlobal);
+        }
+    }
+    estado.somaQualidade[braco] += recompensa;
+}
+
+// Atualização das probabilidades ao fim de um bloco do reativo:
+// qualidade de cada alpha = (melhor global / melhor do alpha)^FATOR_AMPLIFICACAO
+void Algoritmos::atualizarProbabilidades(const std::vector<double>& alphas, EstadoReativo& estado,
+                                         int iter, bool verbose) const {
+    int numAlphas = alphas.size();
+    std::vector<double>& probabilidades = estado.probabilidades;
+    const std::vector<int>& contadorUso = estado.contadorUso;
+    const std::vector<double>& melhorPorAlpha = estado.melhorPorAlpha;
+    double melhorCustoGlobal = estado.melhorCustoGlobal;
+    double FATOR_AMPLIFICACAO = 3;
+
+    if (verbose) {
+        std::cout << "\nIter: " << iter << std::endl;
+
+        for(int i = 0; i < numAlphas; i++) {
+            std::cout << "Alpha: " << alphas[i] << " - Probabilidade: " << probabilidades[i] << std::endl;
+        }
+    }
+
+    // Calcular qualidade de cada alpha
+    std::vector<double> qualidade(numAlphas, 0);
+    double somaQualidades = 0;
+    
+    for (int i = 0; i < numAlphas; i++) {
+        if (contadorUso[i] > 0 && melhorPorAlpha[i] < INFINITO) {
+            // Qualidade = melhor global / melhor do alpha
+            // Quanto menor o custo, maior a qualidade
+            qualidade[i] = melhorCustoGlobal / melhorPorAlpha[i];
+            qualidade[i] = std::pow(qualidade[i], FATOR_AMPLIFICACAO);  // Elevar ao quadrado para amplificar
+        } else {
+            qualidade[i] = 0.1;  // Valor mínimo para alphas não usados
+        }
+        somaQualidades += qualidade[i];
+    }
+
+    if (verbose) {
+        for(int i = 0; i < numAlphas; i++) {
+            std::cout << "Alpha: " << alphas[i] << " - Qualidade: " << qualidade[i] << std::endl;
+        }
+
+        for(int i = 0; i < numAlphas; i++) {
+            std::cout << "Alpha: " << alphas[i] << " - Melhor por Alpha: " << melhorPorAlpha[i] << std::endl;
+        }
+
+        std::cout << "Soma Qualidades: " << somaQualidades << std::endl;
+    }
+    
+    // Normalizar para obter probabilidades
+    if (somaQualidades > 0) {
+        for (int i = 0; i < numAlphas; i++) {
+            probabilidades[i] = qualidade[i] / somaQualidades;
+        }
+    }
+
+    if (verbose) {
+        for(int i = 0; i < numAlphas; i++) {
+            std::cout << "Alpha: " << alphas[i] << " - Nova probabilidade: " << probabilidades[i] << std::endl;
+        }
+    }
+}
+
+// Executa algoritmo guloso randomizado reativo
+Solucao Algoritmos::executarGulosoReativo(const std::vector<double>& alphas, int numIteracoes, int tamanhoBloco, ResultadoExecucao& resultado, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+    
+    int numAlphas = alphas.size();
+    if (numAlphas == 0) {
+        resultado.melhorSolucao = INFINITO;
+        return Solucao(grafo);
+    }
+    
+    // Estado da busca: probabilidades uniformes e estatísticas zeradas,
+    // ou o estado salvo no checkpoint
+    EstadoReativo estado(numAlphas);
+    Solucao melhorSolucaoGlobal(grafo);
+    
+    bool retomado = retomarCheckpoint && !arquivoCheckpoint.empty() &&
+                    Checkpoint::carregar(arquivoCheckpoint, *grafo, alphas, numIteracoes, tamanhoBloco,
+                                         politicaAlpha, larguraAlpha, abandono, construtor, estado);
+    
+    // Um checkpoint existente que não pôde ser retomado seria sobrescrito pela
+    // execução do zero: recusar a execução e preservar o arquivo
+    checkpointRecusado = retomarCheckpoint && !arquivoCheckpoint.empty() && !retomado &&
+                         std::ifstream(arquivoCheckpoint).good();
+    if (checkpointRecusado) {
+        resultado.melhorSolucao = INFINITO;
+        return Solucao(grafo);
+    }
+    
+    if (retomado) {
+        for (int v = 0; v < (int)estado.paisMelhor.size(); v++) {
+            if (v != grafo->getRaiz()) {
+                melhorSolucaoGlobal.setPai(v, estado.paisMelhor[v]);
+            }
+        }
+        melhorSolucaoGlobal.calcularCusto();
+        melhorSolucaoGlobal.verificarViabilidade();
+        
+        if (verbose) {
+            std::cout << "Retomando do checkpoint na iteração " << estado.proximaIteracao << std::endl;
+        }
+    } else if (obterSolucaoInicial(melhorSolucaoGlobal)) {
+        estado.melhorCustoGlobal = melhorSolucaoGlobal.getCustoTotal();
+    }
+    
+    std::vector<int>& contadorUso = estado.contadorUso;
+    std::vector<double>& melhorPorAlpha = estado.melhorPorAlpha;
+    double& melhorCustoGlobal = estado.melhorCustoGlobal;
+    int& melhorAlphaIdx = estado.melhorAlphaIdx;
+    double& somaCustos = estado.somaCustos;
+    
+    // O pool não vai para o checkpoint: ao retomar, recomeça da incumbente
+    std::unique_ptr<PoolSubarvores> pool;
+    if (intervaloRecombinacao > 0) {
+        pool.reset(new PoolSubarvores(grafo, this));
+        if (melhorSolucaoGlobal.isValida()) {
+            pool->adicionar(melhorSolucaoGlobal);
+        }
+    }
+    
+    for (int iter = estado.proximaIteracao; iter < numIteracoes && !cancelado(); iter++) {
+        // Selecionar alpha segundo a política
+        int alphaIdx = escolherBraco(estado);
+        
+        // Construir solução com o alpha selecionado; é abandonada se não puder
+        // melhorar nem o alpha nem a incumbente (as estatísticas ficam exatas)
+        double limiteInferior = -1;
+        double limite = abandono ? std::max(melhorPorAlpha[alphaIdx], melhorCustoGlobal) : INFINITO;
+        Solucao solucaoAtual = construirGulosoRandomizado(alphaDoBraco(alphas, alphaIdx), limite, &limiteInferior);
+        double custoAtual = solucaoAtual.getCustoTotal();
+        bool abandonada = limiteInferior >= 0;
+        if (abandonada) {
+            estado.abandonadas++;
+        } else {
+            somaCustos += custoAtual;
+        }
+        
+        // Atualizar estatísticas (os bandidos aprendem a cada iteração; uma construção
+        // abandonada conta como recompensa zero, e não pelo seu limite inferior otimista)
+        if (politicaAlpha != "roleta") {
+            registrarRecompensa(estado, alphaIdx, custoAtual, !abandonada && solucaoAtual.isValida());
+        }
+        contadorUso[alphaIdx]++;
+        
+        if (!abandonada && custoAtual < melhorPorAlpha[alphaIdx]) {
+            melhorPorAlpha[alphaIdx] = custoAtual;
+        }
+        
+        if (!abandonada && custoAtual < melhorCustoGlobal && solucaoAtual.isValida()) {
+            melhorCustoGlobal = custoAtual;
+            melhorSolucaoGlobal = solucaoAtual;
+            melhorAlphaIdx = alphaIdx;
+        }
+        
+        if (pool) {
+            pool->adicionar(solucaoAtual);
+            if ((iter + 1) % intervaloRecombinacao == 0) {
+                recombinarPool(*pool, melhorSolucaoGlobal, melhorCustoGlobal, verbose);
+            }
+        }
+        
+        if (trace != nullptr) {
+            trace->registrar(iter, alphaIdx, abandonada ? limiteInferior : custoAtual,
+                             !abandonada && solucaoAtual.isValida(), abandonada, melhorCustoGlobal);
+        }
+        
+        // Atualizar probabilidades a cada bloco (apenas roleta)
+        if (politicaAlpha == "roleta" && (iter + 1) % tamanhoBloco == 0 && iter > 0) {
+            atualizarProbabilidades(alphas, estado, iter, verbose);
+        }
+        
+        // Checkpoint periódico (estado entre iterações)
+        estado.proximaIteracao = iter + 1;
+        if (!arquivoCheckpoint.empty() && (iter + 1) % intervaloCheckpoint == 0 && iter + 1 < numIteracoes) {
+            estado.paisMelhor = melhorSolucaoGlobal.getVetorPais();
+            estado.tempoDecorrido += crono.getTempoSegundos();
+            crono.iniciar();
+            Checkpoint::salvar(arquivoCheckpoint, *grafo, alphas, numIteracoes, tamanhoBloco,
+                               politicaAlpha, larguraAlpha, abandono, construtor, estado);
         }
+        
+        if (controle != nullptr) {
+            controle->reportar(iter + 1, numIteracoes, melhorCustoGlobal,
+                               estado.tempoDecorrido + crono.getTempoSegundos());
+        }
+    }
+    
+    if (pool) {
+        recombinarPool(*pool, melhorSolucaoGlobal, melhorCustoGlobal, verbose);
+        pool->preencherResultado(resultado);
+    }
+    
+    // Checkpoint final: retomar uma execução concluída apenas devolve o resultado
+    estado.tempoDecorrido += crono.getTempoSegundos();
+    crono.iniciar();
+    if (!arquivoCheckpoint.empty()) {
+        estado.paisMelhor = melhorSolucaoGlobal.getVetorPais();
+        Checkpoint::salvar(arquivoCheckpoint, *grafo, alphas, numIteracoes, tamanhoBloco,
+                               politicaAlpha, larguraAlpha, abandono, construtor, estado);
+    }
+    
+    if (melhorSolucaoGlobal.isValida()) {
+        posProcessar(melhorSolucaoGlobal, verbose);
+        melhorCustoGlobal = melhorSolucaoGlobal.getCustoTotal();
     }
     
     crono.parar();
@@ -591,15 +1953,529 @@ Solucao Algoritmos::executarGulosoReativo(const std::vector<double>& alphas, int
     resultado.numVertices = grafo->getNumVertices();
     resultado.capacidade = grafo->getCapacidade();
     resultado.algoritmo = "reativo";
+    resultado.construtor = construtor;
     resultado.alpha = -1;  // Vários alphas
-    resultado.iteracoes = numIteracoes;
+    resultado.iteracoes = estado.proximaIteracao;
     resultado.tamanhoBloco = tamanhoBloco;
     resultado.semente = Randomizador::getSemente();
+    resultado.tempoSegundos = estado.tempoDecorrido + crono.getTempoSegundos();
+    resultado.melhorSolucao = melhorCustoGlobal;
+    int concluidas = estado.proximaIteracao - estado.abandonadas;
+    resultado.mediaSolucoes = concluidas > 0 ? somaCustos / concluidas : -1;
+    resultado.taxaAbandono = (abandono && estado.proximaIteracao > 0) ?
+                             (double)estado.abandonadas / estado.proximaIteracao : -1;
+    resultado.melhorAlpha = alphas[melhorAlphaIdx];
+    resultado.solucaoOtima = grafo->getSolucaoOtima();
+    
+    return melhorSolucaoGlobal;
+}
+
+// Modelo de ilhas do reativo
+namespace {
+    // Solução guardada na elite de uma ilha
+    struct MembroElite {
+        double custo;
+        int alphaIdx;           // Alpha que construiu a solução
+        std::vector<int> pais;
+    };
+
+    // Mensagem de migração: elite da ilha de origem e sua distribuição de alphas
+    struct Migrante {
+        std::vector<MembroElite> elite;
+        std::vector<double> probabilidades;
+    };
+
+    const int TAMANHO_ELITE = 3;             // Soluções guardadas (e migradas) por ilha
+    const int CAPACIDADE_FILA_MIGRACAO = 4;  // Mensagens pendentes por ilha (excedente é descartado)
+    const double PESO_MIGRACAO = 0.5;        // Peso da distribuição recebida na mistura
+
+    // Mesma solução (soluções distintas de mesmo custo são mantidas, pela diversidade)
+    bool mesmaSolucao(const MembroElite& a, const MembroElite& b) {
+        return std::fabs(a.custo - b.custo) < 1e-9 && a.pais == b.pais;
+    }
+
+    // Insere na elite, ordenada por custo e sem soluções repetidas
+    void inserirElite(std::vector<MembroElite>& elite, MembroElite membro) {
+        for (const MembroElite& m : elite) {
+            if (mesmaSolucao(m, membro)) {
+                return;
+            }
+        }
+        if ((int)elite.size() >= TAMANHO_ELITE && membro.custo >= elite.back().custo) {
+            return;
+        }
+        auto pos = std::upper_bound(elite.begin(), elite.end(), membro.custo,
+                                    [](double c, const MembroElite& m) { return c < m.custo; });
+        elite.insert(pos, std::move(membro));
+        if ((int)elite.size() > TAMANHO_ELITE) {
+            elite.pop_back();
+        }
+    }
+}
+
+// Executa o reativo em modelo de ilhas com migração em anel
+Solucao Algoritmos::executarGulosoReativoIlhas(const std::vector<double>& alphas, int numIteracoes,
+                                               int tamanhoBloco, int numIlhas, int intervaloMigracao,
+                                               ResultadoExecucao& resultado, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+    
+    int numAlphas = alphas.size();
+    if (numAlphas == 0) {
+        resultado.melhorSolucao = INFINITO;
+        return Solucao(grafo);
+    }
+    numIlhas = std::max(1, numIlhas);
+    if (intervaloMigracao <= 0) {
+        intervaloMigracao = tamanhoBloco;
+    }
+    if (!arquivoCheckpoint.empty()) {
+        std::cerr << "Aviso: checkpoint não se aplica ao reativo em ilhas; ignorado" << std::endl;
+    }
+    if (trace != nullptr) {
+        std::cerr << "Aviso: trace não se aplica ao reativo em ilhas; ignorado" << std::endl;
+    }
+    if (intervaloRecombinacao > 0) {
+        std::cerr << "Aviso: recombinação não se aplica ao reativo em ilhas; ignorada" << std::endl;
+    }
+    
+    // Anel de filas: a ilha i lê da fila i e envia para a fila (i + 1) % numIlhas,
+    // então cada fila tem exatamente um produtor e um consumidor
+    std::vector<std::unique_ptr<FilaSPSC<Migrante>>> filas;
+    for (int i = 0; i < numIlhas; i++) {
+        filas.emplace_back(new FilaSPSC<Migrante>(CAPACIDADE_FILA_MIGRACAO));
+    }
+    
+    std::vector<EstadoReativo> estados(numIlhas, EstadoReativo(numAlphas));
+    std::vector<std::vector<MembroElite>> elites(numIlhas);
+    std::vector<int> iteracoesIlha(numIlhas, 0);
+    std::vector<int> migracoesRecebidas(numIlhas, 0);
+    std::atomic<int> concluidas(0);
+    
+    // Solução de partida: entra na elite de todas as ilhas
+    Solucao inicial(grafo);
+    if (obterSolucaoInicial(inicial)) {
+        for (int i = 0; i < numIlhas; i++) {
+            inserirElite(elites[i], MembroElite{inicial.getCustoTotal(), 0, inicial.getVetorPais()});
+            estados[i].melhorCustoGlobal = inicial.getCustoTotal();
+        }
+    }
+    
+    // Cada ilha usa uma semente derivada da semente da execução (a ilha 0 usa a própria)
+    unsigned int sementeBase = Randomizador::getSemente();
+    
+    // Os índices do grafo são montados sob demanda; montá-los aqui evita que as
+    // ilhas os construam ao mesmo tempo (chamada direta, ou varredura de Q com poda)
+    grafo->prepararIndices();
+    
+    #pragma omp parallel num_threads(numIlhas)
+    {
+        // Com menos threads que ilhas, cada thread atende várias ilhas em sequência
+        for (int ilha = omp_get_thread_num(); ilha < numIlhas; ilha += omp_get_num_threads()) {
+            Randomizador::inicializar(sementeBase + 7919u * ilha);
+            
+            // Cache de construção próprio da ilha
+            Algoritmos local(grafo);
+            local.construtor = construtor;
+            local.politicaAlpha = politicaAlpha;
+            local.larguraAlpha = larguraAlpha;
+            local.abandono = abandono;
+            
+            EstadoReativo& estado = estados[ilha];
+            std::vector<MembroElite>& elite = elites[ilha];
+            std::vector<double> probabilidadesVizinha;
+            int cota = numIteracoes / numIlhas + (ilha < numIteracoes % numIlhas ? 1 : 0);
+            
+            int iter = 0;
+            for (; iter < cota && !cancelado(); iter++) {
+                int alphaIdx = local.escolherBraco(estado);
+                double limiteInferior = -1;
+                double limite = abandono ? std::max(estado.melhorPorAlpha[alphaIdx], estado.melhorCustoGlobal) : INFINITO;
+                Solucao solucaoAtual = local.construirGulosoRandomizado(local.alphaDoBraco(alphas, alphaIdx),
+                                                                        limite, &limiteInferior);
+                double custoAtual = solucaoAtual.getCustoTotal();
+                bool abandonada = limiteInferior >= 0;
+                if (abandonada) {
+                    estado.abandonadas++;
+                } else {
+                    estado.somaCustos += custoAtual;
+                }
+                if (politicaAlpha != "roleta") {
+                    local.registrarRecompensa(estado, alphaIdx, custoAtual, !abandonada && solucaoAtual.isValida());
+                }
+                estado.contadorUso[alphaIdx]++;
+                
+                if (!abandonada && custoAtual < estado.melhorPorAlpha[alphaIdx]) {
+                    estado.melhorPorAlpha[alphaIdx] = custoAtual;
+                }
+                if (!abandonada && solucaoAtual.isValida()) {
+                    if (custoAtual < estado.melhorCustoGlobal) {
+                        estado.melhorCustoGlobal = custoAtual;
+                        estado.melhorAlphaIdx = alphaIdx;
+                    }
+                    if ((int)elite.size() < TAMANHO_ELITE || custoAtual < elite.back().custo) {
+                        inserirElite(elite, MembroElite{custoAtual, alphaIdx, solucaoAtual.getVetorPais()});
+                    }
+                }
+                
+                // Atualização do bloco, puxada em direção à distribuição da vizinha
+                if (politicaAlpha == "roleta" && (iter + 1) % tamanhoBloco == 0 && iter > 0) {
+                    local.atualizarProbabilidades(alphas, estado, iter, false);
+                    if (!probabilidadesVizinha.empty()) {
+                        for (int i = 0; i < numAlphas; i++) {
+                            estado.probabilidades[i] = (1 - PESO_MIGRACAO) * estado.probabilidades[i] +
+                                                       PESO_MIGRACAO * probabilidadesVizinha[i];
+                        }
+                    }
+                }
+                
+                // Migração: envia a elite à próxima ilha do anel e recebe da anterior
+                if (numIlhas > 1 && (iter + 1) % intervaloMigracao == 0) {
+                    Migrante saida;
+                    saida.elite = elite;
+                    saida.probabilidades = estado.probabilidades;
+                    filas[(ilha + 1) % numIlhas]->enviar(std::move(saida));  // Fila cheia: descartada
+                    
+                    Migrante chegada;
+                    while (filas[ilha]->receber(chegada)) {
+                        for (MembroElite& m : chegada.elite) {
+                            estado.melhorCustoGlobal = std::min(estado.melhorCustoGlobal, m.custo);
+                            inserirElite(elite, std::move(m));
+                        }
+                        probabilidadesVizinha = chegada.probabilidades;
+                        migracoesRecebidas[ilha]++;
+                    }
+                }
+                
+                int total = concluidas.fetch_add(1, std::memory_order_relaxed) + 1;
+                if (controle != nullptr && omp_get_thread_num() == 0) {
+                    controle->reportar(total, numIteracoes, estado.melhorCustoGlobal, crono.getTempoSegundos());
+                }
+            }
+            iteracoesIlha[ilha] = iter;
+        }
+    }
+    
+    // Candidatas: elites de todas as ilhas, sem repetição (a migração as replica)
+    std::vector<MembroElite> candidatas;
+    double somaCustos = 0;
+    int totalIteracoes = 0;
+    int totalAbandonadas = 0;
+    for (int i = 0; i < numIlhas; i++) {
+        somaCustos += estados[i].somaCustos;
+        totalIteracoes += iteracoesIlha[i];
+        totalAbandonadas += estados[i].abandonadas;
+        for (const MembroElite& m : elites[i]) {
+            bool repetida = false;
+            for (const MembroElite& c : candidatas) {
+                repetida = repetida || mesmaSolucao(c, m);
+            }
+            if (!repetida) {
+                candidatas.push_back(m);
+            }
+        }
+    }
+    
+    // O pós-processamento pode inverter a ordem: aplicá-lo a todas e ficar com a melhor
+    Solucao melhorSolucaoGlobal(grafo);
+    double melhorCustoGlobal = INFINITO;
+    int melhorAlphaIdx = 0;
+    for (const MembroElite& m : candidatas) {
+        Solucao s(grafo);
+        for (int v = 0; v < (int)m.pais.size(); v++) {
+            if (v != grafo->getRaiz()) {
+                s.setPai(v, m.pais[v]);
+            }
+        }
+        s.calcularCusto();
+        if (!s.verificarViabilidade()) {
+            continue;
+        }
+        posProcessar(s, false);
+        if (s.getCustoTotal() < melhorCustoGlobal) {
+            melhorCustoGlobal = s.getCustoTotal();
+            melhorSolucaoGlobal = s;
+            melhorAlphaIdx = m.alphaIdx;
+        }
+    }
+    
+    crono.parar();
+    
+    if (controle != nullptr) {
+        controle->reportar(totalIteracoes, numIteracoes, melhorCustoGlobal, crono.getTempoSegundos());
+    }
+    
+    if (verbose) {
+        for (int i = 0; i < numIlhas; i++) {
+            std::cout << "Ilha " << i << ": " << iteracoesIlha[i] << " iterações, melhor "
+                      << Utils::formatarDouble(estados[i].melhorCustoGlobal, 2) << ", "
+                      << migracoesRecebidas[i] << " migrações recebidas, probabilidades";
+            for (double p : estados[i].probabilidades) {
+                std::cout << " " << Utils::formatarDouble(p, 3);
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "Melhor após o pós-processamento das elites (" << candidatas.size()
+                  << " soluções): " << Utils::formatarDouble(melhorCustoGlobal, 2) << std::endl;
+    }
+    
+    // Preencher resultado
+    resultado.dataHora = Utils::getDataHoraAtual();
+    resultado.instancia = grafo->getNomeInstancia();
+    resultado.numVertices = grafo->getNumVertices();
+    resultado.capacidade = grafo->getCapacidade();
+    resultado.algoritmo = "reativo-ilhas";
+    resultado.construtor = construtor;
+    resultado.alpha = -1;  // Vários alphas
+    resultado.iteracoes = totalIteracoes;
+    resultado.tamanhoBloco = tamanhoBloco;
+    resultado.semente = sementeBase;
     resultado.tempoSegundos = crono.getTempoSegundos();
     resultado.melhorSolucao = melhorCustoGlobal;
-    resultado.mediaSolucoes = somaCustos / numIteracoes;
+    resultado.mediaSolucoes = totalIteracoes > totalAbandonadas ? somaCustos / (totalIteracoes - totalAbandonadas) : -1;
+    resultado.taxaAbandono = (abandono && totalIteracoes > 0) ? (double)totalAbandonadas / totalIteracoes : -1;
     resultado.melhorAlpha = alphas[melhorAlphaIdx];
     resultado.solucaoOtima = grafo->getSolucaoOtima();
     
     return melhorSolucaoGlobal;
 }
+
+// Laço de ruína e reconstrução do LNS
+Solucao Algoritmos::buscaLNS(const Solucao& inicial, double alpha, int numIteracoes, int numRemover,
+                             int& iteracoesExecutadas, double& somaCustos, bool verbose) const {
+    Cronometro crono;
+    crono.iniciar();
+    
+    Solucao solucaoAtual = inicial;
+    Solucao melhorSolucao = solucaoAtual;
+    double melhorCusto = solucaoAtual.isValida() ? solucaoAtual.getCustoTotal() : INFINITO;
+    
+    iteracoesExecutadas = 0;
+    for (int iter = 0; iter < numIteracoes && !cancelado(); iter++) {
+        Solucao parcial = destruirParcialmente(solucaoAtual, numRemover);
+        Solucao candidata = completarGulosoRandomizado(parcial, alpha);
+        otimizarSubarvoresMST(candidata);
+        
+        double custoCandidata = candidata.getCustoTotal();
+        somaCustos += custoCandidata;
+        
+        if (verbose) {
+            std::cout << "\nIter: " << iter << std::endl;
+            std::cout << "Custo candidata: " << custoCandidata << std::endl;
+            std::cout << "Custo atual: " << solucaoAtual.getCustoTotal() << std::endl;
+            std::cout << "Melhor custo: " << melhorCusto << std::endl;
+        }
+        
+        // Aceitação: não piorar a solução corrente (permite movimentos laterais).
+        // Uma solução corrente inviável (reparo incompleto) é sempre substituída.
+        if (candidata.isValida() &&
+            (!solucaoAtual.isValida() || custoCandidata <= solucaoAtual.getCustoTotal())) {
+            solucaoAtual = candidata;
+            
+            if (custoCandidata < melhorCusto) {
+                melhorCusto = custoCandidata;
+                melhorSolucao = candidata;
+            }
+        }
+        
+        iteracoesExecutadas = iter + 1;
+        if (controle != nullptr) {
+            controle->reportar(iteracoesExecutadas, numIteracoes, melhorCusto, crono.getTempoSegundos());
+        }
+    }
+    
+    return melhorSolucao;
+}
+
+// Executa a busca em vizinhança ampla (ruína e reconstrução)
+Solucao Algoritmos::executarLNS(double alpha, int numIteracoes, double fracaoRemocao,
+                                ResultadoExecucao& resultado, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+    
+    int n = grafo->getNumVertices();
+    int numRemover = std::max(2, (int)std::round(fracaoRemocao * (n - 1)));
+    
+    // Solução inicial: warm start ou construção gulosa, com as subárvores re-otimizadas
+    Solucao solucaoAtual(grafo);
+    if (!obterSolucaoInicial(solucaoAtual)) {
+        solucaoAtual = construirGuloso();
+    }
+    otimizarSubarvoresMST(solucaoAtual);
+    
+    double somaCustos = 0;
+    int iteracoesExecutadas = 0;
+    Solucao melhorSolucao = buscaLNS(solucaoAtual, alpha, numIteracoes, numRemover,
+                                     iteracoesExecutadas, somaCustos, verbose);
+    if (usarTrocaCiclica && melhorSolucao.isValida()) {
+        double ganho = trocaCiclica(melhorSolucao);
+        if (verbose && ganho > 0) {
+            std::cout << "Troca cíclica entre subárvores: -" << ganho << std::endl;
+        }
+    }
+    double melhorCusto = melhorSolucao.isValida() ? melhorSolucao.getCustoTotal() : INFINITO;
+    
+    crono.parar();
+    
+    // Preencher resultado
+    resultado.dataHora = Utils::getDataHoraAtual();
+    resultado.instancia = grafo->getNomeInstancia();
+    resultado.numVertices = grafo->getNumVertices();
+    resultado.capacidade = grafo->getCapacidade();
+    resultado.algoritmo = "lns";
+    resultado.construtor = construtor;
+    resultado.alpha = alpha;
+    resultado.iteracoes = iteracoesExecutadas;
+    resultado.tamanhoBloco = -1;
+    resultado.semente = Randomizador::getSemente();
+    resultado.tempoSegundos = crono.getTempoSegundos();
+    resultado.melhorSolucao = melhorCusto;
+    resultado.mediaSolucoes = iteracoesExecutadas > 0 ? somaCustos / iteracoesExecutadas : -1;
+    resultado.melhorAlpha = -1;
+    resultado.solucaoOtima = grafo->getSolucaoOtima();
+    
+    return melhorSolucao;
+}
+
+// Executa a busca tabu
+Solucao Algoritmos::executarBuscaTabu(int numIteracoes, double tempoLimite,
+                                      ResultadoExecucao& resultado, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+    
+    Solucao inicial(grafo);
+    if (!obterSolucaoInicial(inicial)) {
+        inicial = construirGuloso();
+    }
+    otimizarSubarvoresMST(inicial);
+    
+    BuscaTabu busca(grafo);
+    busca.setControle(controle);
+    int iteracoesExecutadas = 0;
+    Solucao melhorSolucao = busca.executar(inicial, numIteracoes, tempoLimite, iteracoesExecutadas, verbose);
+    
+    // A busca retorna a inicial se não encontrou nada viável; manter a melhor das duas
+    if (!melhorSolucao.isValida() || 
+        (inicial.isValida() && inicial.getCustoTotal() < melhorSolucao.getCustoTotal())) {
+        melhorSolucao = inicial;
+    }
+    posProcessar(melhorSolucao, verbose);
+    
+    crono.parar();
+    
+    // Preencher resultado
+    resultado.dataHora = Utils::getDataHoraAtual();
+    resultado.instancia = grafo->getNomeInstancia();
+    resultado.numVertices = grafo->getNumVertices();
+    resultado.capacidade = grafo->getCapacidade();
+    resultado.algoritmo = "tabu";
+    resultado.construtor = construtor;
+    resultado.alpha = -1;
+    resultado.iteracoes = iteracoesExecutadas;
+    resultado.tamanhoBloco = -1;
+    resultado.semente = Randomizador::getSemente();
+    resultado.tempoSegundos = crono.getTempoSegundos();
+    resultado.melhorSolucao = melhorSolucao.isValida() ? melhorSolucao.getCustoTotal() : INFINITO;
+    resultado.mediaSolucoes = -1;
+    resultado.melhorAlpha = -1;
+    resultado.solucaoOtima = grafo->getSolucaoOtima();
+    
+    return melhorSolucao;
+}
+
+// Re-otimização incremental após alterações na instância
+Solucao Algoritmos::reotimizar(const Solucao& anterior, const EdicaoInstancia& edicoes, int iteracoesLNS,
+                               ResultadoExecucao& resultado, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+    
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+    int capacidade = grafo->getCapacidade();
+    
+    // Copiar a solução anterior para o grafo atual (novos terminais ficam desconectados)
+    Solucao solucao(grafo);
+    const std::vector<int>& paisAnteriores = anterior.getVetorPais();
+    int nAnterior = paisAnteriores.size();
+    for (int v = 0; v < nAnterior && v < n; v++) {
+        if (v != raiz) {
+            solucao.setPai(v, paisAnteriores[v]);
+        }
+    }
+    solucao.verificarViabilidade();
+    
+    std::vector<bool> remover(n, false);
+    
+    // Custos: aresta alterada que pertence à árvore desconecta o filho (o enlace pode
+    // ter encarecido ou sumido); aresta fora da árvore que ficou mais barata que a
+    // ligação atual de uma das pontas desconecta essa ponta para a reinserção avaliá-la
+    for (const EdicaoInstancia::AlteracaoCusto& a : edicoes.custos) {
+        int extremos[2] = {a.origem, a.destino};
+        for (int k = 0; k < 2; k++) {
+            int v = extremos[k];
+            int outro = extremos[1 - k];
+            if (v == raiz || v < 0 || v >= nAnterior || solucao.getPai(v) < 0) continue;
+            
+            if (solucao.getPai(v) == outro) {
+                remover[v] = true;
+            } else if (grafo->existeAresta(v, outro) &&
+                       grafo->getCusto(v, outro) < grafo->getCusto(v, solucao.getPai(v))) {
+                remover[v] = true;
+            }
+        }
+    }
+    
+    // Demandas: subárvore da raiz que passou da capacidade desconecta o vértice alterado
+    for (const EdicaoInstancia::AlteracaoDemanda& a : edicoes.demandas) {
+        int v = a.vertice;
+        if (v == raiz || v < 0 || v >= nAnterior) continue;
+        int s = solucao.getSubarvore(v);
+        if (s > 0 && solucao.getDemandaSubarvore(s) > capacidade) {
+            remover[v] = true;
+        }
+    }
+    
+    Solucao parcial = desconectar(solucao, remover);
+    
+    int afetados = 0;
+    for (int v = 0; v < n; v++) {
+        if (v != raiz && parcial.getPai(v) == -1) afetados++;
+    }
+    
+    // Reinserção gulosa dos afetados (e dos novos terminais) e refinamento local
+    Solucao reparada = completarGulosoRandomizado(parcial, 0.0);
+    otimizarSubarvoresMST(reparada);
+    
+    double somaCustos = 0;
+    int iteracoesExecutadas = 0;
+    int numRemover = std::max(2, (int)std::round(0.1 * (n - 1)));
+    Solucao melhorSolucao = buscaLNS(reparada, 0.02, iteracoesLNS, numRemover,
+                                     iteracoesExecutadas, somaCustos, false);
+    posProcessar(melhorSolucao, verbose);
+    
+    crono.parar();
+    
+    if (verbose) {
+        std::cout << "Re-otimização: " << afetados << " vértices reinseridos, custo do reparo "
+                  << reparada.getCustoTotal() << ", após LNS " << melhorSolucao.getCustoTotal() << std::endl;
+    }
+    
+    // Preencher resultado
+    resultado.dataHora = Utils::getDataHoraAtual();
+    resultado.instancia = grafo->getNomeInstancia();
+    resultado.numVertices = n;
+    resultado.capacidade = capacidade;
+    resultado.algoritmo = "reotimizar";
+    resultado.construtor = construtor;
+    resultado.alpha = -1;
+    resultado.iteracoes = iteracoesExecutadas;
+    resultado.tamanhoBloco = -1;
+    resultado.semente = Randomizador::getSemente();
+    resultado.tempoSegundos = crono.getTempoSegundos();
+    resultado.melhorSolucao = melhorSolucao.isValida() ? melhorSolucao.getCustoTotal() : INFINITO;
+    resultado.mediaSolucoes = -1;
+    resultado.melhorAlpha = -1;
+    resultado.solucaoOtima = -1;  // A instância alterada não tem ótimo conhecido
+    
+    return melhorSolucao;
+}
@@ -0,0 +1,353 @@
+#include "../includes/busca_tabu.h"
+#include "../includes/utils.h"
+#include <algorithm>
+#include <cmath>
+
+// Parâmetros da busca
+static const int NUM_CANDIDATOS = 20;         // Vizinhos mais próximos avaliados por vértice
+static const int TAMANHO_CACHE = 5;           // Melhores jogadas guardadas por vértice
+static const int INTERVALO_PENALIDADE = 10;   // Iterações entre ajustes da penalidade
+
+// Construtor
+BuscaTabu::BuscaTabu(const Grafo* g)
+    : grafo(g), n(g->getNumVertices()), raiz(g->getRaiz()), capacidade(g->getCapacidade()),
+      custoAtual(0), excessoAtual(0), penalidade(1), controle(nullptr) {
+    primeiroFilho.resize(n, -1);
+    proximoIrmao.resize(n, -1);
+    entrada.resize(n, 0);
+    tamanho.resize(n, 0);
+    demandaDesc.resize(n, 0);
+    raizSub.resize(n, -1);
+    ordem.reserve(n);
+
+    // Vizinhança restrita e índice reverso (independentes da solução)
+    candidatos.resize(n);
+    reversos.resize(n);
+    for (int v = 0; v < n; v++) {
+        if (v == raiz) continue;
+        for (int p : grafo->getVizinhosOrdenados(v)) {
+            if ((int)candidatos[v].size() >= NUM_CANDIDATOS) break;
+            if (p == raiz) continue;
+            candidatos[v].push_back(p);
+            reversos[p].push_back(v);
+        }
+    }
+
+    cacheMovimentos.resize(n);
+    cacheValido.resize(n, 0);
+}
+
+// Excesso de capacidade de uma subárvore
+int BuscaTabu::excesso(int demanda) const {
+    return demanda > capacidade ? demanda - capacidade : 0;
+}
+
+// Valor penalizado de um movimento
+double BuscaTabu::avaliacao(const MovimentoTabu& mov) const {
+    return mov.deltaCusto + penalidade * mov.deltaExcesso;
+}
+
+// Verifica se religar v a p é tabu na iteração informada
+bool BuscaTabu::ehTabu(int v, int p, int iter) const {
+    auto it = tabu.find((long long)v * n + p);
+    return it != tabu.end() && it->second >= iter;
+}
+
+// Recalcula as estruturas derivadas do vetor de pais em O(n)
+void BuscaTabu::recalcularEstruturas() {
+    std::fill(primeiroFilho.begin(), primeiroFilho.end(), -1);
+    for (int v = n - 1; v >= 0; v--) {
+        if (v != raiz && pai[v] >= 0) {
+            proximoIrmao[v] = primeiroFilho[pai[v]];
+            primeiroFilho[pai[v]] = v;
+        }
+    }
+
+    // Pré-ordem iterativa: a subárvore de v ocupa [entrada[v], entrada[v] + tamanho[v])
+    ordem.clear();
+    std::vector<int> pilha;
+    pilha.push_back(raiz);
+    while (!pilha.empty()) {
+        int v = pilha.back();
+        pilha.pop_back();
+        entrada[v] = ordem.size();
+        ordem.push_back(v);
+        raizSub[v] = (v == raiz) ? -1 : (pai[v] == raiz ? v : raizSub[pai[v]]);
+        for (int f = primeiroFilho[v]; f != -1; f = proximoIrmao[f]) {
+            pilha.push_back(f);
+        }
+    }
+
+    // Tamanhos e demandas acumulados em pré-ordem reversa
+    for (int v : ordem) {
+        tamanho[v] = 1;
+        demandaDesc[v] = grafo->getDemanda(v);
+    }
+    for (int i = (int)ordem.size() - 1; i > 0; i--) {
+        int v = ordem[i];
+        tamanho[pai[v]] += tamanho[v];
+        demandaDesc[pai[v]] += demandaDesc[v];
+    }
+
+    custoAtual = 0;
+    excessoAtual = 0;
+    for (int v : ordem) {
+        if (v == raiz) continue;
+        custoAtual += grafo->getCusto(v, pai[v]);
+        if (pai[v] == raiz) {
+            excessoAtual += excesso(demandaDesc[v]);
+        }
+    }
+}
+
+// Avalia a religação de v (com sua subárvore) ao novo pai p
+bool BuscaTabu::avaliar(int v, int p, MovimentoTabu& mov) const {
+    if (p == v || p == pai[v] || !grafo->existeAresta(v, p)) {
+        return false;
+    }
+
+    // p não pode ser descendente de v (formaria ciclo)
+    if (p != raiz && entrada[p] >= entrada[v] && entrada[p] < entrada[v] + tamanho[v]) {
+        return false;
+    }
+
+    int a = raizSub[v];
+    int d = demandaDesc[v];
+    int demandaA = demandaDesc[a];
+    int deltaExcesso;
+
+    if (p == raiz) {
+        // v passa a iniciar uma nova subárvore
+        deltaExcesso = excesso(demandaA - d) - excesso(demandaA) + excesso(d);
+    } else {
+        int b = raizSub[p];
+        if (a == b) {
+            deltaExcesso = 0;
+        } else {
+            int demandaB = demandaDesc[b];
+            deltaExcesso = excesso(demandaA - d) - excesso(demandaA)
+                         + excesso(demandaB + d) - excesso(demandaB);
+        }
+    }
+
+    mov = MovimentoTabu(v, p, grafo->getCusto(v, p) - grafo->getCusto(v, pai[v]), deltaExcesso);
+    return true;
+}
+
+// Recalcula as melhores jogadas de um vértice
+void BuscaTabu::atualizarCache(int v) {
+    std::vector<MovimentoTabu>& lista = cacheMovimentos[v];
+    lista.clear();
+
+    MovimentoTabu mov;
+    if (avaliar(v, raiz, mov)) {
+        lista.push_back(mov);
+    }
+    for (int p : candidatos[v]) {
+        if (avaliar(v, p, mov)) {
+            lista.push_back(mov);
+        }
+    }
+
+    int manter = std::min((int)lista.size(), TAMANHO_CACHE);
+    std::partial_sort(lista.begin(), lista.begin() + manter, lista.end(),
+                      [this](const MovimentoTabu& a, const MovimentoTabu& b) {
+                          return avaliacao(a) < avaliacao(b);
+                      });
+    lista.resize(manter);
+    cacheValido[v] = 1;
+}
+
+// Define o controle externo
+void BuscaTabu::setControle(const ControleExecucao* c) {
+    controle = c;
+}
+
+// Executa a busca tabu
+Solucao BuscaTabu::executar(const Solucao& inicial, int maxIteracoes, double tempoLimite,
+                            int& iteracoesExecutadas, bool verbose) {
+    Cronometro crono;
+    crono.iniciar();
+
+    pai = inicial.getVetorPais();
+    recalcularEstruturas();
+    tabu.clear();
+    std::fill(cacheValido.begin(), cacheValido.end(), 0);
+
+    // Penalidade inicial: custo médio de ligar um vértice à raiz
+    double somaRaiz = 0;
+    int contaRaiz = 0;
+    for (int v = 0; v < n; v++) {
+        if (v != raiz && grafo->existeAresta(v, raiz)) {
+            somaRaiz += grafo->getCusto(v, raiz);
+            contaRaiz++;
+        }
+    }
+    double penalidadeBase = contaRaiz > 0 ? somaRaiz / contaRaiz : 1;
+    penalidade = penalidadeBase;
+
+    std::vector<int> melhorPai = pai;
+    double melhorCusto = (excessoAtual == 0 && (int)ordem.size() == n) ? custoAtual : INFINITO;
+    int iteracoesViaveis = 0;
+
+    std::vector<int> invalidos;
+    std::vector<char> afetado(n, 0);
+    int iter = 0;
+
+    for (; iter < maxIteracoes; iter++) {
+        if (tempoLimite > 0 && crono.getTempoSegundos() >= tempoLimite) {
+            break;
+        }
+        if (controle != nullptr && controle->isCancelado()) {
+            break;
+        }
+
+        // Recalcular (em paralelo) apenas os caches invalidados
+        invalidos.clear();
+        for (int v = 0; v < n; v++) {
+            if (v != raiz && !cacheValido[v]) {
+                invalidos.push_back(v);
+            }
+        }
+        #pragma omp parallel for schedule(dynamic, 16) if (invalidos.size() >= 256)
+        for (int i = 0; i < (int)invalidos.size(); i++) {
+            atualizarCache(invalidos[i]);
+        }
+
+        // Selecionar o melhor movimento admissível (não tabu ou aspirado)
+        MovimentoTabu melhorMov;
+        double melhorValor = INFINITO;
+
+        #pragma omp parallel if (n >= 1024)
+        {
+            MovimentoTabu movLocal;
+            double valorLocal = INFINITO;
+
+            #pragma omp for schedule(static) nowait
+            for (int v = 0; v < n; v++) {
+                if (v == raiz) continue;
+
+                auto admissivel = [&](const MovimentoTabu& m) {
+                    if (!ehTabu(m.vertice, m.novoPai, iter)) return true;
+                    return excessoAtual + m.deltaExcesso == 0 &&
+                           custoAtual + m.deltaCusto < melhorCusto - 1e-9;
+                };
+                auto considerar = [&](const MovimentoTabu& m) {
+                    double valor = avaliacao(m);
+                    if (valor < valorLocal ||
+                        (valor == valorLocal && (m.vertice < movLocal.vertice ||
+                         (m.vertice == movLocal.vertice && m.novoPai < movLocal.novoPai)))) {
+                        valorLocal = valor;
+                        movLocal = m;
+                    }
+                };
+
+                bool encontrou = false;
+                for (const MovimentoTabu& m : cacheMovimentos[v]) {
+                    if (admissivel(m)) {
+                        considerar(m);
+                        encontrou = true;
+                        break;
+                    }
+                }
+
+                // Todas as jogadas em cache são tabu: varrer a vizinhança completa
+                if (!encontrou && !cacheMovimentos[v].empty()) {
+                    MovimentoTabu m;
+                    if (avaliar(v, raiz, m) && admissivel(m)) considerar(m);
+                    for (int p : candidatos[v]) {
+                        if (avaliar(v, p, m) && admissivel(m)) considerar(m);
+                    }
+                }
+            }
+
+            #pragma omp critical
+            {
+                if (valorLocal < melhorValor ||
+                    (valorLocal == melhorValor && valorLocal < INFINITO &&
+                     (movLocal.vertice < melhorMov.vertice ||
+                      (movLocal.vertice == melhorMov.vertice && movLocal.novoPai < melhorMov.novoPai)))) {
+                    melhorValor = valorLocal;
+                    melhorMov = movLocal;
+                }
+            }
+        }
+
+        if (melhorMov.vertice < 0) {
+            break;  // Nenhum movimento admissível
+        }
+
+        // Subárvores da raiz afetadas: origem e destino do movimento
+        int v = melhorMov.vertice;
+        int p = melhorMov.novoPai;
+        int subOrigem = raizSub[v];
+        int subDestino = (p == raiz) ? v : raizSub[p];
+
+        for (int u = 0; u < n; u++) {
+            afetado[u] = (u != raiz && (raizSub[u] == subOrigem || raizSub[u] == subDestino));
+        }
+
+        // Aplicar movimento e registrar atributo tabu (v não volta para o pai antigo)
+        int mandato = Randomizador::randInt(7, 7 + n / 20);
+        tabu[(long long)v * n + pai[v]] = iter + mandato;
+        pai[v] = p;
+        recalcularEstruturas();
+
+        // Invalidar caches dos vértices das subárvores afetadas e de quem as tem como candidatas
+        for (int u = 0; u < n; u++) {
+            if (!afetado[u]) continue;
+            cacheValido[u] = 0;
+            for (int w : reversos[u]) {
+                cacheValido[w] = 0;
+            }
+        }
+
+        if (excessoAtual == 0) {
+            iteracoesViaveis++;
+            if (custoAtual < melhorCusto - 1e-9) {
+                melhorCusto = custoAtual;
+                melhorPai = pai;
+
+                if (verbose) {
+                    std::cout << "Iter " << iter << ": nova melhor solução " << melhorCusto
+                              << " (penalidade " << penalidade << ")" << std::endl;
+                }
+            }
+        }
+
+        // Penalidade adaptativa: aumenta se a busca ficou só em regiões inviáveis,
+        // diminui se ficou só em regiões viáveis
+        if ((iter + 1) % INTERVALO_PENALIDADE == 0) {
+            double anterior = penalidade;
+            if (iteracoesViaveis == 0) {
+                penalidade = std::min(penalidade * 2, penalidadeBase * 100);
+            } else if (iteracoesViaveis == INTERVALO_PENALIDADE) {
+                penalidade = std::max(penalidade / 1.5, penalidadeBase / 100);
+            }
+            iteracoesViaveis = 0;
+
+            if (penalidade != anterior) {
+                std::fill(cacheValido.begin(), cacheValido.end(), 0);
+            }
+        }
+
+        if (controle != nullptr) {
+            controle->reportar(iter + 1, maxIteracoes, melhorCusto, crono.getTempoSegundos());
+        }
+    }
+
+    iteracoesExecutadas = iter;
+
+    Solucao melhor(inicial);
+    if (melhorCusto < INFINITO) {
+        for (int v = 0; v < n; v++) {
+            if (v != raiz) {
+                melhor.setPai(v, melhorPai[v]);
+            }
+        }
+    }
+    melhor.calcularCusto();
+    melhor.verificarViabilidade();
+
+    return melhor;
+}
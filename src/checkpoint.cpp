@@ -0,0 +1,174 @@
+#include "../includes/checkpoint.h"
+#include "../includes/utils.h"
+#include <sstream>
+#include <cstdlib>
+#include <cstdio>
+
+// Versão do formato do arquivo (a 1 não tem política nem pior custo, a 2 não tem
+// abandono e a 3 não tem construtor; só a versão atual é aceita)
+static const char* PREFIXO_CHECKPOINT = "CMST_CHECKPOINT_REATIVO ";
+static const int VERSAO_CHECKPOINT = 4;
+
+EstadoReativo::EstadoReativo(int numAlphas)
+    : probabilidades(numAlphas, numAlphas > 0 ? 1.0 / numAlphas : 0),
+      somaQualidade(numAlphas, 0), contadorUso(numAlphas, 0),
+      melhorPorAlpha(numAlphas, INFINITO), proximaIteracao(0), somaCustos(0),
+      melhorCustoGlobal(INFINITO), piorCusto(0), melhorAlphaIdx(0), abandonadas(0), tempoDecorrido(0) {}
+
+// Real em hexadecimal: representação exata e legível por strtod
+static std::string hex(double valor) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%a", valor);
+    return buffer;
+}
+
+static bool lerReal(std::istream& in, double& valor) {
+    std::string token;
+    if (!(in >> token)) return false;
+    char* fim = nullptr;
+    valor = std::strtod(token.c_str(), &fim);
+    return fim != token.c_str() && *fim == '\0';
+}
+
+// Lê "rotulo" e confere se é o esperado
+static bool esperar(std::istream& in, const std::string& rotulo) {
+    std::string token;
+    return (in >> token) && token == rotulo;
+}
+
+static void escreverReais(std::ostream& out, const char* rotulo, const std::vector<double>& v) {
+    out << rotulo;
+    for (double x : v) out << " " << hex(x);
+    out << "\n";
+}
+
+static bool lerReais(std::istream& in, const char* rotulo, std::vector<double>& v) {
+    if (!esperar(in, rotulo)) return false;
+    for (double& x : v) {
+        if (!lerReal(in, x)) return false;
+    }
+    return true;
+}
+
+bool Checkpoint::salvar(const std::string& arquivo, const Grafo& grafo,
+                        const std::vector<double>& alphas, int numIteracoes, int tamanhoBloco,
+                        const std::string& politica, double largura, bool abandono,
+                        const std::string& construtor, const EstadoReativo& estado) {
+    std::stringstream out;
+    out << PREFIXO_CHECKPOINT << VERSAO_CHECKPOINT << "\n";
+    out << "instancia " << grafo.hashConteudo() << " " << grafo.getCapacidade() << "\n";
+    out << "parametros " << numIteracoes << " " << tamanhoBloco << " " << alphas.size() << "\n";
+    escreverReais(out, "alphas", alphas);
+    out << "politica " << politica << " " << hex(largura) << "\n";
+    out << "abandono " << (abandono ? 1 : 0) << "\n";
+    out << "construtor " << construtor << "\n";
+    out << "iteracao " << estado.proximaIteracao << "\n";
+    out << "tempo " << hex(estado.tempoDecorrido) << "\n";
+    out << "soma_custos " << hex(estado.somaCustos) << "\n";
+    out << "melhor " << hex(estado.melhorCustoGlobal) << " " << estado.melhorAlphaIdx << "\n";
+    out << "pior " << hex(estado.piorCusto) << "\n";
+    out << "abandonadas " << estado.abandonadas << "\n";
+    escreverReais(out, "probabilidades", estado.probabilidades);
+    escreverReais(out, "soma_qualidade", estado.somaQualidade);
+    out << "contador_uso";
+    for (int c : estado.contadorUso) out << " " << c;
+    out << "\n";
+    escreverReais(out, "melhor_por_alpha", estado.melhorPorAlpha);
+    std::vector<int> pais = grafo.paisParaOriginal(estado.paisMelhor);  // IDs do arquivo
+    out << "pais " << pais.size();
+    for (int p : pais) out << " " << p;
+    out << "\n";
+    out << "rng ";
+    Randomizador::salvarEstado(out);
+    out << "\n";
+    
+    return Utils::gravarArquivoAtomico(arquivo, out.str());
+}
+
+bool Checkpoint::carregar(const std::string& arquivo, const Grafo& grafo,
+                          const std::vector<double>& alphas, int numIteracoes, int tamanhoBloco,
+                          const std::string& politica, double largura, bool abandono,
+                          const std::string& construtor, EstadoReativo& estado) {
+    std::ifstream in(arquivo);
+    if (!in.is_open()) {
+        return false;
+    }
+    
+    std::string linha;
+    std::getline(in, linha);
+    int versao = 0;
+    if (linha.compare(0, std::string(PREFIXO_CHECKPOINT).size(), PREFIXO_CHECKPOINT) == 0) {
+        versao = std::atoi(linha.c_str() + std::string(PREFIXO_CHECKPOINT).size());
+    }
+    if (versao >= 1 && versao < VERSAO_CHECKPOINT) {
+        std::cerr << "Checkpoint de versão anterior (sem o construtor), recomece sem --resume: " << arquivo << std::endl;
+        return false;
+    }
+    if (versao != VERSAO_CHECKPOINT) {
+        std::cerr << "Checkpoint com formato desconhecido: " << arquivo << std::endl;
+        return false;
+    }
+    
+    // Conferir se o checkpoint é desta instância e destes parâmetros
+    unsigned long long hash = 0;
+    int capacidade = 0, iteracoesArq = 0, blocoArq = 0;
+    size_t numAlphas = 0;
+    if (!esperar(in, "instancia") || !(in >> hash >> capacidade) ||
+        !esperar(in, "parametros") || !(in >> iteracoesArq >> blocoArq >> numAlphas)) {
+        return false;
+    }
+    std::vector<double> alphasArq(numAlphas);
+    if (!lerReais(in, "alphas", alphasArq)) {
+        return false;
+    }
+    std::string politicaArq, construtorArq;
+    double larguraArq = 0;
+    int abandonoArq = 0;
+    if (!esperar(in, "politica") || !(in >> politicaArq) || !lerReal(in, larguraArq) ||
+        !esperar(in, "abandono") || !(in >> abandonoArq) ||
+        !esperar(in, "construtor") || !(in >> construtorArq)) {
+        return false;
+    }
+    if (hash != grafo.hashConteudo() || capacidade != grafo.getCapacidade() ||
+        iteracoesArq != numIteracoes || blocoArq != tamanhoBloco || alphasArq != alphas ||
+        politicaArq != politica || larguraArq != largura || (abandonoArq != 0) != abandono ||
+        construtorArq != construtor) {
+        std::cerr << "Checkpoint não corresponde à instância/parâmetros atuais: " << arquivo << std::endl;
+        return false;
+    }
+    
+    EstadoReativo lido(alphas.size());
+    size_t numPais = 0;
+    bool ok = esperar(in, "iteracao") && (in >> lido.proximaIteracao) &&
+              esperar(in, "tempo") && lerReal(in, lido.tempoDecorrido) &&
+              esperar(in, "soma_custos") && lerReal(in, lido.somaCustos) &&
+              esperar(in, "melhor") && lerReal(in, lido.melhorCustoGlobal) && (in >> lido.melhorAlphaIdx) &&
+              esperar(in, "pior") && lerReal(in, lido.piorCusto) &&
+              esperar(in, "abandonadas") && (in >> lido.abandonadas) &&
+              lerReais(in, "probabilidades", lido.probabilidades) &&
+              lerReais(in, "soma_qualidade", lido.somaQualidade) &&
+              esperar(in, "contador_uso");
+    for (size_t i = 0; ok && i < lido.contadorUso.size(); i++) {
+        ok = (bool)(in >> lido.contadorUso[i]);
+    }
+    ok = ok && lerReais(in, "melhor_por_alpha", lido.melhorPorAlpha) &&
+         esperar(in, "pais") && (in >> numPais);
+    if (ok) {
+        lido.paisMelhor.resize(numPais);
+        for (size_t i = 0; ok && i < numPais; i++) {
+            ok = (bool)(in >> lido.paisMelhor[i]);
+        }
+    }
+    ok = ok && esperar(in, "rng") && Randomizador::carregarEstado(in);
+    if (ok && (int)lido.paisMelhor.size() == grafo.getNumVertices()) {
+        lido.paisMelhor = grafo.paisParaInterno(lido.paisMelhor);
+    }
+    
+    if (!ok) {
+        std::cerr << "Checkpoint corrompido: " << arquivo << std::endl;
+        return false;
+    }
+    
+    estado = lido;
+    return true;
+}
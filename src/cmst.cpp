@@ -0,0 +1,229 @@
+#include "../includes/cmst.h"
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+// Troca os valores -1 pelos padrões do algoritmo
+ParametrosExecucao ParametrosExecucao::comPadroes() const {
+    ParametrosExecucao p = *this;
+
+    if (p.numIteracoes < 0) {
+        if (p.algoritmo == "reativo") {
+            p.numIteracoes = 300;
+        } else if (p.algoritmo == "lns") {
+            p.numIteracoes = 500;
+        } else if (p.algoritmo == "tabu") {
+            p.numIteracoes = 5000;
+        } else if (p.algoritmo == "reotimizar") {
+            p.numIteracoes = 20;  // Iterações de refinamento por LNS
+        } else {
+            p.numIteracoes = 30;
+        }
+    }
+
+    // LNS: reinserção quase gulosa
+    if (p.alpha < 0) {
+        p.alpha = (p.algoritmo == "lns") ? 0.02 : 0.3;
+    }
+
+    // Faixa contínua: um braço por subintervalo, representado pelo seu centro
+    if (p.alphaMax > p.alphaMin && p.numBracos > 0) {
+        double largura = (p.alphaMax - p.alphaMin) / p.numBracos;
+        p.alphas.clear();
+        for (int i = 0; i < p.numBracos; i++) {
+            p.alphas.push_back(p.alphaMin + (i + 0.5) * largura);
+        }
+    }
+
+    return p;
+}
+
+// Opções que alteram a busca e não têm coluna própria no CSV, na forma
+// "nome" ou "nome=valor" separadas por espaço (parâmetros já com os padrões)
+static std::string descreverOpcoes(const ParametrosExecucao& p) {
+    std::ostringstream opcoes;
+    auto acrescentar = [&opcoes](const std::string& opcao) {
+        if (opcoes.tellp() > 0) opcoes << " ";
+        opcoes << opcao;
+    };
+
+    if (p.algoritmo == "reativo") {
+        std::ostringstream alphas;
+        if (p.alphaMax > p.alphaMin && p.numBracos > 0) {
+            alphas << "alpha-faixa=" << p.alphaMin << ":" << p.alphaMax << " bracos=" << p.numBracos;
+        } else {
+            alphas << "alphas=";
+            for (size_t i = 0; i < p.alphas.size(); i++) {
+                alphas << (i > 0 ? "/" : "") << p.alphas[i];
+            }
+        }
+        acrescentar(alphas.str());
+        if (p.numIlhas > 1) {
+            acrescentar("ilhas=" + std::to_string(p.numIlhas) + " migracao=" + std::to_string(p.intervaloMigracao));
+        }
+    } else if (p.algoritmo == "lns") {
+        std::ostringstream remocao;
+        remocao << "remocao=" << p.fracaoRemocao;
+        acrescentar(remocao.str());
+    } else if (p.algoritmo == "tabu") {
+        std::ostringstream tempo;
+        tempo << "tempo=" << p.tempoLimite;
+        acrescentar(tempo.str());
+    }
+    if (p.abandono) acrescentar("abandono");
+    if (p.intervaloRecombinacao > 0) acrescentar("recombinar=" + std::to_string(p.intervaloRecombinacao));
+    if (p.trocaCiclica) acrescentar("troca-ciclica");
+    return opcoes.str();
+}
+
+// Despacha para o algoritmo pedido (parâmetros já com os padrões)
+static bool despacharAlgoritmo(Algoritmos& alg, const ParametrosExecucao& p, ResultadoExecucao& resultado,
+                               Solucao& melhorSolucao, bool verbose) {
+    if (p.algoritmo == "guloso") {
+        if (verbose) {
+            std::cout << "Executando algoritmo guloso..." << std::endl;
+        }
+        melhorSolucao = alg.executarGuloso(resultado, verbose);
+
+    } else if (p.algoritmo == "randomizado") {
+        if (verbose) {
+            std::cout << "Executando algoritmo randomizado..." << std::endl;
+            std::cout << "  Alpha: " << p.alpha << std::endl;
+            std::cout << "  Iterações: " << p.numIteracoes << std::endl;
+        }
+        melhorSolucao = alg.executarGulosoRandomizado(p.alpha, p.numIteracoes, resultado, verbose);
+
+    } else if (p.algoritmo == "reativo") {
+        if (verbose) {
+            std::cout << "Executando algoritmo reativo..." << std::endl;
+            std::cout << "  Alphas: ";
+            for (size_t i = 0; i < p.alphas.size(); i++) {
+                std::cout << p.alphas[i];
+                if (i < p.alphas.size() - 1) std::cout << ", ";
+            }
+            std::cout << std::endl;
+            std::cout << "  Iterações: " << p.numIteracoes << std::endl;
+            std::cout << "  Tamanho do bloco: " << p.tamanhoBloco << std::endl;
+            std::cout << "  Política de alpha: " << p.politicaAlpha << std::endl;
+            if (p.numIlhas > 1) {
+                std::cout << "  Ilhas: " << p.numIlhas << std::endl;
+            }
+        }
+        if (p.retomar && p.arquivoCheckpoint.empty()) {
+            std::cerr << "Aviso: --resume requer --checkpoint <arquivo>; iniciando do zero" << std::endl;
+        }
+        double largura = (p.alphaMax > p.alphaMin && p.numBracos > 0) ? (p.alphaMax - p.alphaMin) / p.numBracos : 0;
+        if (!alg.setPoliticaAlpha(p.politicaAlpha, largura)) {
+            return false;
+        }
+        alg.configurarCheckpoint(p.arquivoCheckpoint, p.intervaloCheckpoint, p.retomar);
+        if (p.numIlhas > 1) {
+            melhorSolucao = alg.executarGulosoReativoIlhas(p.alphas, p.numIteracoes, p.tamanhoBloco, p.numIlhas,
+                                                           p.intervaloMigracao, resultado, verbose);
+        } else {
+            melhorSolucao = alg.executarGulosoReativo(p.alphas, p.numIteracoes, p.tamanhoBloco, resultado, verbose);
+        }
+
+    } else if (p.algoritmo == "lns") {
+        if (verbose) {
+            std::cout << "Executando LNS (ruína e reconstrução)..." << std::endl;
+            std::cout << "  Alpha: " << p.alpha << std::endl;
+            std::cout << "  Iterações: " << p.numIteracoes << std::endl;
+            std::cout << "  Fração de remoção: " << p.fracaoRemocao << std::endl;
+        }
+        melhorSolucao = alg.executarLNS(p.alpha, p.numIteracoes, p.fracaoRemocao, resultado, verbose);
+
+    } else if (p.algoritmo == "tabu") {
+        if (verbose) {
+            std::cout << "Executando busca tabu..." << std::endl;
+            std::cout << "  Iterações máximas: " << p.numIteracoes << std::endl;
+            std::cout << "  Tempo limite: " << p.tempoLimite << " s" << std::endl;
+        }
+        melhorSolucao = alg.executarBuscaTabu(p.numIteracoes, p.tempoLimite, resultado, verbose);
+
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+// Executa um dos algoritmos de solução
+bool CMST::executarAlgoritmo(Algoritmos& alg, const ParametrosExecucao& parametros, ResultadoExecucao& resultado,
+                             Solucao& melhorSolucao, bool verbose, std::string* erro) {
+    ParametrosExecucao p = parametros.comPadroes();
+    alg.setAbandono(p.abandono);
+    alg.setTrocaCiclica(p.trocaCiclica);
+    alg.setRecombinacao(p.intervaloRecombinacao);
+
+    // Trace de convergência: aberto só durante a execução do algoritmo e
+    // alocado só quando pedido (a fila pré-alocada ocupa 2 MB)
+    std::unique_ptr<RegistroTrace> trace;
+    if (!p.arquivoTrace.empty()) {
+        trace.reset(new RegistroTrace());
+        if (trace->abrir(p.arquivoTrace)) {
+            alg.setTrace(trace.get());
+        } else {
+            std::cerr << "Aviso: não foi possível criar o trace " << p.arquivoTrace << std::endl;
+            trace.reset();
+        }
+    }
+
+    bool ok = despacharAlgoritmo(alg, p, resultado, melhorSolucao, verbose);
+    if (!ok && erro != nullptr) {
+        *erro = "Algoritmo desconhecido: " + p.algoritmo;
+    }
+    if (ok && p.algoritmo == "reativo" && p.numIlhas <= 1 && alg.isCheckpointRecusado()) {
+        ok = false;
+        if (erro != nullptr) {
+            *erro = "Checkpoint não pode ser retomado com estes parâmetros: " + p.arquivoCheckpoint +
+                    " (preservado; corrija as opções ou remova --resume e use outro arquivo)";
+        }
+    }
+    if (p.algoritmo == "reativo") {
+        resultado.politicaAlpha = p.politicaAlpha;
+    }
+    resultado.opcoes = descreverOpcoes(p);
+
+    if (trace) {
+        alg.setTrace(nullptr);
+        trace->fechar();
+        if (trace->getDescartados() > 0) {
+            std::cerr << "Aviso: " << trace->getDescartados() << " eventos do trace descartados (fila cheia)" << std::endl;
+        }
+    }
+    return ok;
+}
+
+// Resolve a instância com o algoritmo e os parâmetros dados
+bool CMST::resolver(const Grafo& grafo, const ParametrosExecucao& p, Solucao& solucao,
+                    ResultadoExecucao& resultado, const ControleExecucao* controle, std::string* erro,
+                    bool verbose) {
+    Algoritmos alg(&grafo);
+    if (!alg.setConstrutor(p.construtor)) {
+        if (erro != nullptr) {
+            *erro = "Construtor desconhecido: " + p.construtor + " (use prim ou kruskal)";
+        }
+        return false;
+    }
+    if (!alg.setPoliticaAlpha(p.politicaAlpha)) {
+        if (erro != nullptr) {
+            *erro = "Política de alpha desconhecida: " + p.politicaAlpha + " (use roleta, ucb1 ou thompson)";
+        }
+        return false;
+    }
+    alg.setSolucaoInicial(p.paisIniciais);
+    alg.setControle(controle);
+
+    if (p.usarSemente) {
+        Randomizador::inicializar(p.semente);
+    }
+
+    grafo.prepararIndices();
+    solucao = Solucao(&grafo);
+    if (!executarAlgoritmo(alg, p, resultado, solucao, verbose, erro)) {
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,204 @@
+#include "../includes/comparacao.h"
+#include "../includes/estatistica.h"
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <deque>
+#include <cmath>
+
+namespace {
+    std::vector<std::string> dividirCampos(const std::string& linha) {
+        std::vector<std::string> campos;
+        std::stringstream ss(linha);
+        std::string campo;
+        while (std::getline(ss, campo, ',')) {
+            campos.push_back(campo);
+        }
+        if (!linha.empty() && linha.back() == ',') {
+            campos.push_back("");
+        }
+        return campos;
+    }
+
+    // Custo de execução sem solução ("inf") ou ilegível vira INFINITY
+    double lerNumero(const std::string& texto) {
+        try {
+            return std::stod(texto);
+        } catch (...) {
+            return INFINITY;
+        }
+    }
+
+    // Colunas que distinguem as configurações, com o rótulo usado no relatório
+    const std::vector<std::pair<std::string, std::string>> COLUNAS_CONFIGURACAO = {
+        {"capacidade", "Q="}, {"alpha", "alpha="}, {"iteracoes", "iter="}, {"tamanho_bloco", "bloco="},
+        {"construtor", "construtor="}, {"politica_alpha", "politica="}, {"opcoes", ""}};
+
+    // Configuração não vazia nas colunas dadas (as presentes nos dois arquivos)
+    std::string descreverConfiguracao(const ExecucaoCSV& e, const std::vector<std::pair<std::string, std::string>>& colunas) {
+        std::string texto;
+        for (const auto& c : colunas) {
+            auto it = e.configuracao.find(c.first);
+            if (it != e.configuracao.end() && !it->second.empty()) {
+                if (!texto.empty()) texto += " ";
+                texto += c.second + it->second;
+            }
+        }
+        return texto;
+    }
+
+    // Colunas de configuração presentes em todas as execuções
+    std::vector<std::pair<std::string, std::string>> colunasComuns(const std::vector<ExecucaoCSV>& a,
+                                                                    const std::vector<ExecucaoCSV>& b) {
+        std::vector<std::pair<std::string, std::string>> comuns;
+        for (const auto& c : COLUNAS_CONFIGURACAO) {
+            bool presente = true;
+            for (const std::vector<ExecucaoCSV>* execucoes : {&a, &b}) {
+                for (const ExecucaoCSV& e : *execucoes) {
+                    presente = presente && e.configuracao.count(c.first) > 0;
+                }
+            }
+            if (presente) comuns.push_back(c);
+        }
+        return comuns;
+    }
+
+    // Diferença de custo; duas execuções sem solução empatam
+    double diferencaCusto(double a, double b) {
+        if (!std::isfinite(a) && !std::isfinite(b)) {
+            return 0;
+        }
+        return b - a;
+    }
+}
+
+// Lê o CSV pelas colunas do cabeçalho
+bool Comparacao::lerCSV(const std::string& arquivo, std::vector<ExecucaoCSV>& execucoes, std::string& erro) {
+    std::ifstream entrada(arquivo);
+    if (!entrada) {
+        erro = "Não foi possível abrir " + arquivo;
+        return false;
+    }
+
+    std::string linha;
+    if (!std::getline(entrada, linha)) {
+        erro = "Arquivo vazio: " + arquivo;
+        return false;
+    }
+    std::vector<std::string> cabecalho = dividirCampos(linha);
+    std::map<std::string, int> coluna;
+    for (size_t i = 0; i < cabecalho.size(); i++) {
+        coluna[cabecalho[i]] = i;
+    }
+    for (const char* obrigatoria : {"instancia", "algoritmo", "semente", "tempo_segundos", "melhor_solucao"}) {
+        if (!coluna.count(obrigatoria)) {
+            erro = std::string("Coluna '") + obrigatoria + "' ausente em " + arquivo;
+            return false;
+        }
+    }
+
+    while (std::getline(entrada, linha)) {
+        if (!linha.empty() && linha.back() == '\r') linha.pop_back();
+        std::vector<std::string> campos = dividirCampos(linha);
+        if (campos.size() != cabecalho.size() || campos == cabecalho) {
+            continue;  // Linha vazia, truncada ou cabeçalho repetido
+        }
+        ExecucaoCSV e;
+        e.instancia = campos[coluna["instancia"]];
+        e.algoritmo = campos[coluna["algoritmo"]];
+        e.semente = campos[coluna["semente"]];
+        e.tempoSegundos = lerNumero(campos[coluna["tempo_segundos"]]);
+        e.custo = lerNumero(campos[coluna["melhor_solucao"]]);
+        for (const auto& c : COLUNAS_CONFIGURACAO) {
+            auto it = coluna.find(c.first);
+            if (it != coluna.end()) {
+                e.configuracao[c.first] = campos[it->second];
+            }
+        }
+        execucoes.push_back(e);
+    }
+    return true;
+}
+
+// Pareamento por (grupo, semente) e testes por grupo
+ResultadoComparacao Comparacao::comparar(const std::vector<ExecucaoCSV>& a, const std::vector<ExecucaoCSV>& b,
+                                         const OpcoesComparacao& opcoes) {
+    ResultadoComparacao r;
+    r.semParA = 0;
+    r.regressoes = 0;
+
+    // Chave do grupo: instância, algoritmo e configuração nas colunas comuns
+    std::vector<std::pair<std::string, std::string>> colunas = colunasComuns(a, b);
+    auto chaveGrupo = [&colunas](const ExecucaoCSV& e) {
+        return e.instancia + "|" + e.algoritmo + "|" + descreverConfiguracao(e, colunas);
+    };
+
+    std::map<std::string, std::deque<int>> pendentesB;
+    for (int j = 0; j < (int)b.size(); j++) {
+        pendentesB[chaveGrupo(b[j]) + "|" + b[j].semente].push_back(j);
+    }
+
+    std::map<std::string, std::vector<std::pair<int, int>>> pares;
+    for (int i = 0; i < (int)a.size(); i++) {
+        std::deque<int>& fila = pendentesB[chaveGrupo(a[i]) + "|" + a[i].semente];
+        if (fila.empty()) {
+            r.semParA++;
+            continue;
+        }
+        pares[chaveGrupo(a[i])].push_back({i, fila.front()});
+        fila.pop_front();
+    }
+    r.semParB = 0;
+    for (const auto& par : pendentesB) {
+        r.semParB += par.second.size();
+    }
+
+    for (const auto& grupo : pares) {
+        const ExecucaoCSV& primeira = a[grupo.second.front().first];
+        GrupoComparacao g;
+        g.instancia = primeira.instancia;
+        g.algoritmo = primeira.algoritmo;
+        g.parametros = descreverConfiguracao(primeira, colunas);
+        g.numPares = grupo.second.size();
+
+        std::vector<double> custosA, custosB, temposA, temposB, difCusto, difTempo, relTempo;
+        for (const auto& p : grupo.second) {
+            const ExecucaoCSV& ea = a[p.first];
+            const ExecucaoCSV& eb = b[p.second];
+            custosA.push_back(ea.custo);
+            custosB.push_back(eb.custo);
+            temposA.push_back(ea.tempoSegundos);
+            temposB.push_back(eb.tempoSegundos);
+            difCusto.push_back(diferencaCusto(ea.custo, eb.custo));
+            difTempo.push_back(eb.tempoSegundos - ea.tempoSegundos);
+            if (ea.tempoSegundos > 0) {
+                relTempo.push_back(eb.tempoSegundos / ea.tempoSegundos - 1);
+            }
+        }
+        g.custoA = Estatistica::mediana(custosA);
+        g.custoB = Estatistica::mediana(custosB);
+        g.deltaCusto = Estatistica::mediana(difCusto);
+        g.tempoA = Estatistica::mediana(temposA);
+        g.tempoB = Estatistica::mediana(temposB);
+        g.deltaTempo = relTempo.empty() ? 0 : Estatistica::mediana(relTempo);
+
+        // O sentido vem de W+ (B maior que A quando W+ passa da média n(n+1)/4)
+        Estatistica::ResultadoWilcoxon wc = Estatistica::wilcoxon(difCusto);
+        Estatistica::ResultadoWilcoxon wt = Estatistica::wilcoxon(difTempo);
+        g.valorPCusto = wc.valorP;
+        g.valorPTempo = wt.valorP;
+        bool custoSignificativo = wc.valorP < opcoes.nivel;
+        bool tempoSignificativo = wt.valorP < opcoes.nivel && std::fabs(g.deltaTempo) > opcoes.toleranciaTempo;
+        bool custoMaior = wc.somaPositivos > wc.numPares * (wc.numPares + 1) / 4.0;
+        bool tempoMaior = wt.somaPositivos > wt.numPares * (wt.numPares + 1) / 4.0;
+        g.regressaoCusto = custoSignificativo && custoMaior;
+        g.melhoraCusto = custoSignificativo && !custoMaior;
+        g.regressaoTempo = tempoSignificativo && tempoMaior;
+        g.melhoraTempo = tempoSignificativo && !tempoMaior;
+        if (g.regressaoCusto || g.regressaoTempo) {
+            r.regressoes++;
+        }
+        r.grupos.push_back(g);
+    }
+    return r;
+}
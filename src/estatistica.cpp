@@ -0,0 +1,273 @@
+#include "../includes/estatistica.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace {
+    const int MAX_ITERACOES_SERIE = 500;
+    const double EPSILON_SERIE = 1e-14;
+    const double MENOR_REAL = 1e-300;
+    const int MAX_PARES_EXATO = 50;  // Wilcoxon: acima disso, aproximação normal
+
+    // Função gama incompleta regularizada P(a, x): série para x < a + 1,
+    // fração contínua (Lentz) para o complemento no restante
+    double gamaIncompleta(double a, double x) {
+        if (x <= 0) {
+            return 0;
+        }
+        double logPrefixo = a * std::log(x) - x - std::lgamma(a);
+        if (x < a + 1) {
+            double termo = 1.0 / a;
+            double soma = termo;
+            for (int n = 1; n < MAX_ITERACOES_SERIE; n++) {
+                termo *= x / (a + n);
+                soma += termo;
+                if (std::fabs(termo) < std::fabs(soma) * EPSILON_SERIE) break;
+            }
+            return soma * std::exp(logPrefixo);
+        }
+        double b = x + 1 - a;
+        double c = 1 / MENOR_REAL;
+        double d = 1 / b;
+        double h = d;
+        for (int i = 1; i < MAX_ITERACOES_SERIE; i++) {
+            double an = -i * (i - a);
+            b += 2;
+            d = an * d + b;
+            if (std::fabs(d) < MENOR_REAL) d = MENOR_REAL;
+            c = b + an / c;
+            if (std::fabs(c) < MENOR_REAL) c = MENOR_REAL;
+            d = 1 / d;
+            double delta = d * c;
+            h *= delta;
+            if (std::fabs(delta - 1) < EPSILON_SERIE) break;
+        }
+        return 1 - std::exp(logPrefixo) * h;
+    }
+
+    // Fração contínua da beta incompleta (Lentz)
+    double fracaoBeta(double a, double b, double x) {
+        double qab = a + b;
+        double qap = a + 1;
+        double qam = a - 1;
+        double c = 1;
+        double d = 1 - qab * x / qap;
+        if (std::fabs(d) < MENOR_REAL) d = MENOR_REAL;
+        d = 1 / d;
+        double h = d;
+        for (int m = 1; m < MAX_ITERACOES_SERIE; m++) {
+            int m2 = 2 * m;
+            double aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+            d = 1 + aa * d;
+            if (std::fabs(d) < MENOR_REAL) d = MENOR_REAL;
+            c = 1 + aa / c;
+            if (std::fabs(c) < MENOR_REAL) c = MENOR_REAL;
+            d = 1 / d;
+            h *= d * c;
+            aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+            d = 1 + aa * d;
+            if (std::fabs(d) < MENOR_REAL) d = MENOR_REAL;
+            c = 1 + aa / c;
+            if (std::fabs(c) < MENOR_REAL) c = MENOR_REAL;
+            d = 1 / d;
+            double delta = d * c;
+            h *= delta;
+            if (std::fabs(delta - 1) < EPSILON_SERIE) break;
+        }
+        return h;
+    }
+
+    // Função beta incompleta regularizada I_x(a, b)
+    double betaIncompleta(double a, double b, double x) {
+        if (x <= 0) return 0;
+        if (x >= 1) return 1;
+        double logPrefixo = std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) +
+                            a * std::log(x) + b * std::log(1 - x);
+        if (x < (a + 1) / (a + b + 2)) {
+            return std::exp(logPrefixo) * fracaoBeta(a, b, x) / a;
+        }
+        return 1 - std::exp(logPrefixo) * fracaoBeta(b, a, 1 - x) / b;
+    }
+}
+
+// Postos com média nos empates
+std::vector<double> Estatistica::postos(const std::vector<double>& valores) {
+    int n = valores.size();
+    std::vector<int> ordem(n);
+    std::iota(ordem.begin(), ordem.end(), 0);
+    std::sort(ordem.begin(), ordem.end(), [&](int a, int b) { return valores[a] < valores[b]; });
+
+    std::vector<double> resultado(n);
+    int i = 0;
+    while (i < n) {
+        int j = i;
+        while (j + 1 < n && valores[ordem[j + 1]] == valores[ordem[i]]) {
+            j++;
+        }
+        double posto = (i + j) / 2.0 + 1;
+        for (int k = i; k <= j; k++) {
+            resultado[ordem[k]] = posto;
+        }
+        i = j + 1;
+    }
+    return resultado;
+}
+
+double Estatistica::distribuicaoQuiQuadrado(double x, int gl) {
+    return gamaIncompleta(gl / 2.0, x / 2.0);
+}
+
+double Estatistica::distribuicaoT(double x, int gl) {
+    double cauda = betaIncompleta(gl / 2.0, 0.5, gl / (gl + x * x)) / 2;
+    return x >= 0 ? 1 - cauda : cauda;
+}
+
+// Quantil da t por bisseção sobre a função de distribuição
+double Estatistica::quantilT(double p, int gl) {
+    double baixo = -1;
+    double alto = 1;
+    while (distribuicaoT(baixo, gl) > p) baixo *= 2;
+    while (distribuicaoT(alto, gl) < p) alto *= 2;
+    for (int i = 0; i < 100; i++) {
+        double meio = (baixo + alto) / 2;
+        if (distribuicaoT(meio, gl) < p) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    return (baixo + alto) / 2;
+}
+
+double Estatistica::distribuicaoNormal(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+double Estatistica::mediana(std::vector<double> valores) {
+    int n = valores.size();
+    if (n == 0) {
+        return NAN;
+    }
+    std::sort(valores.begin(), valores.end());
+    return n % 2 == 1 ? valores[n / 2] : (valores[n / 2 - 1] + valores[n / 2]) / 2;
+}
+
+// Postos sinalizados de Wilcoxon
+Estatistica::ResultadoWilcoxon Estatistica::wilcoxon(const std::vector<double>& diferencas) {
+    ResultadoWilcoxon r;
+    r.somaPositivos = 0;
+    r.valorP = 1;
+    r.exato = true;
+
+    std::vector<double> modulos;
+    std::vector<bool> positiva;
+    for (double d : diferencas) {
+        if (d != 0 && !std::isnan(d)) {
+            modulos.push_back(std::fabs(d));
+            positiva.push_back(d > 0);
+        }
+    }
+    int n = modulos.size();
+    r.numPares = n;
+    if (n == 0) {
+        return r;
+    }
+
+    std::vector<double> p = postos(modulos);
+    for (int i = 0; i < n; i++) {
+        if (positiva[i]) r.somaPositivos += p[i];
+    }
+
+    if (n <= MAX_PARES_EXATO) {
+        // Distribuição exata: cada posto entra em W+ com probabilidade 1/2; os
+        // postos dobrados são inteiros mesmo com empates (médias de meio posto)
+        int total = n * (n + 1);
+        std::vector<double> prob(total + 1, 0);
+        prob[0] = 1;
+        int alcance = 0;
+        for (int i = 0; i < n; i++) {
+            int dobro = (int)std::lround(2 * p[i]);
+            for (int s = alcance; s >= 0; s--) {
+                if (prob[s] == 0) continue;
+                prob[s + dobro] += prob[s] / 2;
+                prob[s] /= 2;
+            }
+            alcance += dobro;
+        }
+        int w = (int)std::lround(2 * r.somaPositivos);
+        double abaixo = 0;
+        double acima = 0;
+        for (int s = 0; s <= total; s++) {
+            if (s <= w) abaixo += prob[s];
+            if (s >= w) acima += prob[s];
+        }
+        r.valorP = std::min(1.0, 2 * std::min(abaixo, acima));
+        return r;
+    }
+
+    // Aproximação normal: variância corrigida pelos grupos de empates
+    r.exato = false;
+    double media = n * (n + 1) / 4.0;
+    double variancia = n * (n + 1) * (2.0 * n + 1) / 24.0;
+    std::vector<double> ordenados = modulos;
+    std::sort(ordenados.begin(), ordenados.end());
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j + 1 < n && ordenados[j + 1] == ordenados[i]) j++;
+        double t = j - i + 1;
+        variancia -= (t * t * t - t) / 48.0;
+        i = j + 1;
+    }
+    if (variancia <= 0) {
+        return r;
+    }
+    double z = (std::fabs(r.somaPositivos - media) - 0.5) / std::sqrt(variancia);
+    r.valorP = std::min(1.0, 2 * (1 - distribuicaoNormal(std::max(0.0, z))));
+    return r;
+}
+
+// Teste de Friedman e diferença crítica de Conover
+Estatistica::ResultadoFriedman Estatistica::friedman(const std::vector<std::vector<double>>& blocos, double nivel) {
+    ResultadoFriedman r;
+    r.estatistica = 0;
+    r.valorP = 1;
+    r.diferencaCritica = INFINITY;
+
+    int b = blocos.size();
+    int k = b > 0 ? blocos[0].size() : 0;
+    r.somaPostos.assign(k, 0);
+    if (b == 0 || k < 2) {
+        return r;
+    }
+
+    // Soma dos postos por tratamento e soma dos quadrados de todos os postos
+    double somaQuadrados = 0;
+    for (const std::vector<double>& bloco : blocos) {
+        std::vector<double> p = postos(bloco);
+        for (int t = 0; t < k; t++) {
+            r.somaPostos[t] += p[t];
+            somaQuadrados += p[t] * p[t];
+        }
+    }
+
+    double termoEmpate = b * k * (k + 1) * (k + 1) / 4.0;
+    double variacao = somaQuadrados - termoEmpate;
+    if (variacao <= 0) {
+        return r;  // Todos os postos empatados em todos os blocos
+    }
+
+    double desvios = 0;
+    for (int t = 0; t < k; t++) {
+        double d = r.somaPostos[t] - b * (k + 1) / 2.0;
+        desvios += d * d;
+    }
+    r.estatistica = (k - 1) * desvios / variacao;
+    r.valorP = 1 - distribuicaoQuiQuadrado(r.estatistica, k - 1);
+
+    if (b > 1) {
+        int gl = (b - 1) * (k - 1);
+        double fator = 2.0 * b * variacao / gl * (1 - r.estatistica / (b * (k - 1.0)));
+        r.diferencaCritica = quantilT(1 - nivel / 2, gl) * std::sqrt(std::max(0.0, fator));
+    }
+    return r;
+}
@@ -1,16 +1,137 @@
 #include "../includes/grafo.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
 
 // Construtor padrão
-Grafo::Grafo() : numVertices(0), capacidade(0), raiz(0), solucaoOtima(-1) {}
+Grafo::Grafo()
+    : numVertices(0), capacidade(0), raiz(0), simetrica(true), esparsa(false), solucaoOtima(-1), vizinhosValidos(false),
+      podaAtiva(false), numArestasEliminadas(0), numArestasTotal(0) {}
 
 // Construtor com parâmetros
-Grafo::Grafo(int n, int cap) : numVertices(n), capacidade(cap), raiz(0), solucaoOtima(-1) {
-    matrizAdj.resize(n, std::vector<double>(n, INFINITO));
+Grafo::Grafo(int n, int cap)
+    : numVertices(n), capacidade(cap), raiz(0), simetrica(true), esparsa(false), solucaoOtima(-1), vizinhosValidos(false),
+      podaAtiva(false), numArestasEliminadas(0), numArestasTotal(0) {
+    std::vector<double> completa((size_t)n * n, INFINITO);
     demandas.resize(n, 1);  // Demanda unitária por padrão
     
     // Diagonal principal = 0 (custo para si mesmo)
     for (int i = 0; i < n; i++) {
-        matrizAdj[i][i] = 0;
+        completa[(size_t)i * n + i] = 0;
+    }
+    montarArmazenamento(completa);
+}
+
+// Arredonda para múltiplo de 8 doubles (64 bytes)
+static size_t alinharLinha(size_t k) {
+    return (k + 7) & ~(size_t)7;
+}
+
+// Monta o armazenamento, compactando se a matriz for simétrica
+void Grafo::montarArmazenamento(const std::vector<double>& completa) {
+    int n = numVertices;
+    
+    simetrica = true;
+    for (int i = 0; i < n && simetrica; i++) {
+        for (int j = 0; j < i; j++) {
+            if (completa[(size_t)i * n + j] != completa[(size_t)j * n + i]) {
+                simetrica = false;
+                break;
+            }
+        }
+    }
+    
+    inicioLinha.resize(n);
+    size_t total = 0;
+    for (int i = 0; i < n; i++) {
+        inicioLinha[i] = total;
+        total += alinharLinha(simetrica ? i + 1 : n);
+    }
+    
+    custos.assign(total, INFINITO);
+    for (int i = 0; i < n; i++) {
+        int comprimento = simetrica ? i + 1 : n;
+        std::memcpy(&custos[inicioLinha[i]], &completa[(size_t)i * n], comprimento * sizeof(double));
+    }
+}
+
+// Posição da aresta por busca binária na linha de origem
+int Grafo::posicaoCSR(int origem, int destino) const {
+    const int* inicio = vizinhosCSR.data() + inicioCSR[origem];
+    const int* fim = vizinhosCSR.data() + inicioCSR[origem + 1];
+    const int* it = std::lower_bound(inicio, fim, destino);
+    return (it != fim && *it == destino) ? (int)(it - vizinhosCSR.data()) : -1;
+}
+
+// Atualiza a aresta ou a insere na posição ordenada da linha (O(m))
+void Grafo::definirCustoCSR(int origem, int destino, double custo) {
+    int k = posicaoCSR(origem, destino);
+    if (k >= 0) {
+        custosCSR[k] = custo;
+        return;
+    }
+    auto inicio = vizinhosCSR.begin() + inicioCSR[origem];
+    auto fim = vizinhosCSR.begin() + inicioCSR[origem + 1];
+    k = std::lower_bound(inicio, fim, destino) - vizinhosCSR.begin();
+    vizinhosCSR.insert(vizinhosCSR.begin() + k, destino);
+    custosCSR.insert(custosCSR.begin() + k, custo);
+    for (int v = origem + 1; v <= numVertices; v++) {
+        inicioCSR[v]++;
+    }
+}
+
+// Ordena cada lista por vizinho, mantendo o menor custo das arestas repetidas
+void Grafo::montarCSR(std::vector<std::vector<std::pair<int, double>>>& listas) {
+    int n = listas.size();
+    esparsa = true;
+    custos.clear();
+    custos.shrink_to_fit();
+    inicioLinha.clear();
+    
+    inicioCSR.assign(n + 1, 0);
+    vizinhosCSR.clear();
+    custosCSR.clear();
+    for (int v = 0; v < n; v++) {
+        std::vector<std::pair<int, double>>& lista = listas[v];
+        std::sort(lista.begin(), lista.end());
+        for (size_t i = 0; i < lista.size(); i++) {
+            if (lista[i].first == v || (i > 0 && lista[i].first == lista[i - 1].first)) {
+                continue;  // Laço ou repetida (a primeira é a de menor custo)
+            }
+            vizinhosCSR.push_back(lista[i].first);
+            custosCSR.push_back(lista[i].second);
+        }
+        inicioCSR[v + 1] = vizinhosCSR.size();
+    }
+}
+
+void Grafo::descartarCSR() {
+    esparsa = false;
+    inicioCSR.clear();
+    vizinhosCSR.clear();
+    custosCSR.clear();
+}
+
+// Passa para o armazenamento completo
+void Grafo::expandirParaCompleta() {
+    if (!simetrica) {
+        return;
+    }
+    
+    int n = numVertices;
+    std::vector<double> completa((size_t)n * n);
+    for (int i = 0; i < n; i++) {
+        copiarLinha(i, &completa[(size_t)i * n]);
+    }
+    
+    // A matriz copiada é simétrica: montar diretamente no formato completo
+    simetrica = false;
+    size_t passo = alinharLinha(n);
+    inicioLinha.resize(n);
+    custos.assign(passo * n, INFINITO);
+    for (int i = 0; i < n; i++) {
+        inicioLinha[i] = passo * i;
+        std::memcpy(&custos[inicioLinha[i]], &completa[(size_t)i * n], n * sizeof(double));
     }
 }
 
@@ -27,10 +148,27 @@ bool Grafo::carregarInstancia(const std::string& nomeArquivo) {
 
     // Extrair nome da instância do caminho
     size_t pos = nomeArquivo.find_last_of("/\\");
-    nomeInstancia = (pos != std::string::npos) ? nomeArquivo.substr(pos + 1) : nomeArquivo;
+    return lerInstancia(arquivo, (pos != std::string::npos) ? nomeArquivo.substr(pos + 1) : nomeArquivo);
+}
+
+// Carrega instância de um texto em memória (mesmo formato do arquivo)
+bool Grafo::carregarInstanciaTexto(const std::string& conteudo, const std::string& nome) {
+    std::istringstream entrada(conteudo);
+    return lerInstancia(entrada, nome);
+}
+
+// Lê a instância no formato OR-Library de um fluxo
+bool Grafo::lerInstancia(std::istream& arquivo, const std::string& nome) {
+    nomeInstancia = nome;
 
-    // Ler primeira linha: n Q
-    arquivo >> numVertices >> capacidade;
+    // Ler primeira linha: n Q (ou ARESTAS n Q na lista de arestas)
+    std::string primeiro;
+    arquivo >> primeiro;
+    if (primeiro == "ARESTAS") {
+        return lerListaArestas(arquivo, nome);
+    }
+    numVertices = std::atoi(primeiro.c_str());
+    arquivo >> capacidade;
 
     if (numVertices <= 0 || capacidade <= 0) {
         std::cerr << "Erro: Valores inválidos para n ou Q" << std::endl;
@@ -38,45 +176,55 @@ bool Grafo::carregarInstancia(const std::string& nomeArquivo) {
     }
 
     // Inicializar estruturas
-    matrizAdj.resize(numVertices, std::vector<double>(numVertices, INFINITO));
-    demandas.resize(numVertices, 1);  // Demanda unitária
+    invalidarIndices();
+    descartarCSR();
+    podaAtiva = false;
+    arestaEliminada.clear();
+    idOriginal.clear();
+    idInterno.clear();
     raiz = 0;  // Primeiro vértice é a raiz
 
     // Ler matriz de distâncias
-    // O formato usa largura fixa de 4 caracteres por valor
-    // Quando valores pequenos precedem 1000 na diagonal, ficam concatenados (ex: "311000" = 31 e 1000)
     
-    std::string conteudo;
     std::string linha;
     std::getline(arquivo, linha);  // Consumir resto da primeira linha
 
-    // Ler todo o conteúdo restante, guardando a última linha separadamente para verificar se há solução ótima
+    // Extrair valores linha a linha, guardando a última linha para verificar se há solução ótima.
+    // O formato usa largura fixa de 4 caracteres por valor; linhas fora desse padrão
+    // são lidas por tokens, separando concatenações com 1000 (ex: "311000" = 31 e 1000)
+    std::vector<double> valores;
     std::string ultimaLinha;
     while (std::getline(arquivo, linha)) {
         // Remover \r se houver (Windows line endings)
         if (!linha.empty() && linha.back() == '\r') {
             linha.pop_back();
         }
-        // conteudo += linha + " ";
+        if (linha.find_first_not_of(' ') == std::string::npos) {
+            continue;
+        }
+        ultimaLinha = linha;  // Guardar última linha não vazia
 
-        if (!linha.empty()) {
-            ultimaLinha = linha;  // Guardar última linha não vazia
-            conteudo += linha + " ";
+        if (linha.length() % 4 == 0) {
+            bool valida = true;
+            std::vector<double> campos;
+            for (size_t pos = 0; pos < linha.length() && valida; pos += 4) {
+                try {
+                    campos.push_back(std::stod(linha.substr(pos, 4)));
+                } catch (...) {
+                    valida = false;
+                }
+            }
+            if (valida) {
+                valores.insert(valores.end(), campos.begin(), campos.end());
+                continue;
+            }
         }
-    }
-    arquivo.close();
-    
-    // Extrair valores considerando largura fixa e concatenações
-    std::vector<double> valores;
-    std::istringstream iss(conteudo);
-    std::string token;
-    
-    while (iss >> token) {
-        // Verificar se é valor concatenado com 1000
-        // Pattern: número pequeno seguido de 1000 (ex: "311000", "601000")
-        if (token.length() > 4 && token.length() <= 7) {
-            // Verificar se termina com 1000
-            if (token.substr(token.length() - 4) == "1000") {
+
+        std::istringstream iss(linha);
+        std::string token;
+        while (iss >> token) {
+            // Verificar se é valor concatenado com 1000
+            if (token.length() > 4 && token.length() <= 7 && token.substr(token.length() - 4) == "1000") {
                 std::string antes = token.substr(0, token.length() - 4);
                 if (!antes.empty()) {
                     try {
@@ -86,16 +234,21 @@ bool Grafo::carregarInstancia(const std::string& nomeArquivo) {
                 valores.push_back(1000);
                 continue;
             }
-        }
-        
-        try {
-            valores.push_back(std::stod(token));
-        } catch (...) {
-            // Ignorar tokens inválidos
+            
+            try {
+                valores.push_back(std::stod(token));
+            } catch (...) {
+                // Ignorar tokens inválidos
+            }
         }
     }
 
-    // Calcular quantos valores esperamos para a matriz n×n
+    // A matriz traz a raiz mais os n terminais ((n+1)×(n+1)); arquivos com
+    // apenas n×n valores têm a raiz entre os n vértices
+    int terminais = numVertices;
+    if ((long long)valores.size() >= (long long)(terminais + 1) * (terminais + 1)) {
+        numVertices = terminais + 1;
+    }
     int esperado = numVertices * numVertices;
     
     if ((int)valores.size() < esperado) {
@@ -103,37 +256,29 @@ bool Grafo::carregarInstancia(const std::string& nomeArquivo) {
         std::cerr << "Esperado: " << esperado << ", Encontrado: " << valores.size() << std::endl;
         return false;
     }
+    
+    demandas.assign(numVertices, 1);  // Demanda unitária
 
-    // Preencher matriz de adjacência
+    // Preencher matriz de custos
+    std::vector<double> completa((size_t)numVertices * numVertices);
     int idx = 0;
     for (int i = 0; i < numVertices; i++) {
         for (int j = 0; j < numVertices; j++) {
             double custo = valores[idx++];
             // Valor 1000 na diagonal representa o próprio vértice (sem aresta)
-            if (i == j) {
-                matrizAdj[i][j] = 0;
-            } else {
-                matrizAdj[i][j] = custo;
-            }
+            completa[(size_t)i * numVertices + j] = (i == j) ? 0 : custo;
         }
     }
+    montarArmazenamento(completa);
 
-    // Verificar se há solução ótima na última linha do arquivo
-    // A solução ótima aparece como uma linha separada com apenas um número
+    // Solução ótima: valor isolado após a matriz, na última linha do arquivo
     solucaoOtima = -1;  // Padrão: não disponível
     
-    if (!ultimaLinha.empty()) {
-        // Verificar se a última linha contém apenas um número (possivelmente com espaços)
+    if ((int)valores.size() > esperado && !ultimaLinha.empty()) {
         std::istringstream ultimaIss(ultimaLinha);
         std::string primeiroToken;
         ultimaIss >> primeiroToken;
-
-
-        std::cout << "Primeiro token: " << primeiroToken << std::endl;
-        std::cout << "Valores: " << valores.size() << std::endl;
-        std::cout << "Esperado: " << esperado << std::endl;
     
-        // Se há apenas um token e é um número válido, é a solução ótima
         if (!primeiroToken.empty()) {
             try {
                 solucaoOtima = std::stod(primeiroToken);
@@ -146,6 +291,105 @@ bool Grafo::carregarInstancia(const std::string& nomeArquivo) {
     return true;
 }
 
+// Lê a lista de arestas (grafo esparso): "u v custo" por linha, mais DEMANDA e OTIMO opcionais
+bool Grafo::lerListaArestas(std::istream& entrada, const std::string& nome) {
+    int terminais = 0;
+    int cap = 0;
+    if (!(entrada >> terminais >> cap) || terminais <= 0 || cap <= 0) {
+        std::cerr << "Erro: Valores inválidos para n ou Q" << std::endl;
+        return false;
+    }
+    
+    int n = terminais + 1;
+    std::vector<std::vector<std::pair<int, double>>> listas(n);
+    std::vector<int> demandasLidas(n, 1);  // Demanda unitária por padrão
+    double otimo = -1;
+    
+    std::string linha;
+    std::getline(entrada, linha);  // Consumir resto da primeira linha
+    while (std::getline(entrada, linha)) {
+        if (!linha.empty() && linha.back() == '\r') {
+            linha.pop_back();
+        }
+        std::istringstream iss(linha);
+        std::string token;
+        if (!(iss >> token) || token[0] == '#') {
+            continue;
+        }
+        
+        bool valida;
+        if (token == "DEMANDA") {
+            int v, d;
+            valida = (iss >> v >> d) && v >= 0 && v < n && d >= 0;
+            if (valida) demandasLidas[v] = d;
+        } else if (token == "OTIMO") {
+            valida = (bool)(iss >> otimo);
+        } else {
+            std::istringstream aresta(linha);
+            int u, v;
+            double c;
+            valida = (aresta >> u >> v >> c) && u >= 0 && u < n && v >= 0 && v < n;
+            if (valida && u != v) {
+                listas[u].push_back({v, c});
+                listas[v].push_back({u, c});
+            }
+        }
+        if (!valida) {
+            std::cerr << "Erro: Linha inválida na lista de arestas: '" << linha << "'" << std::endl;
+            return false;
+        }
+    }
+    
+    nomeInstancia = nome;
+    numVertices = n;
+    capacidade = cap;
+    raiz = 0;
+    solucaoOtima = otimo;
+    demandas.swap(demandasLidas);
+    invalidarIndices();
+    podaAtiva = false;
+    arestaEliminada.clear();
+    idOriginal.clear();
+    idInterno.clear();
+    simetrica = true;
+    montarCSR(listas);
+    return true;
+}
+
+// Carrega a instância de uma matriz de custos em memória
+bool Grafo::carregarMatriz(int n, int cap, const double* matriz, const int* demandasVertices,
+                           int raizInstancia, const std::string& nome) {
+    if (n <= 0 || cap <= 0 || matriz == nullptr || raizInstancia < 0 || raizInstancia >= n) {
+        std::cerr << "Erro: Valores inválidos para n, Q ou raiz" << std::endl;
+        return false;
+    }
+    
+    numVertices = n;
+    capacidade = cap;
+    raiz = raizInstancia;
+    nomeInstancia = nome;
+    solucaoOtima = -1;
+    invalidarIndices();
+    descartarCSR();
+    podaAtiva = false;
+    arestaEliminada.clear();
+    idOriginal.clear();
+    idInterno.clear();
+    
+    demandas.assign(n, 1);
+    if (demandasVertices != nullptr) {
+        demandas.assign(demandasVertices, demandasVertices + n);
+    }
+    
+    std::vector<double> completa(matriz, matriz + (size_t)n * n);
+    for (int i = 0; i < n; i++) {
+        completa[(size_t)i * n + i] = 0;
+    }
+    montarArmazenamento(completa);
+    
+    return true;
+}
+
 // Getters
 int Grafo::getNumVertices() const {
     return numVertices;
@@ -170,7 +414,14 @@ double Grafo::getCusto(int origem, int destino) const {
     if (origem < 0 || origem >= numVertices || destino < 0 || destino >= numVertices) {
         return INFINITO;
     }
-    return matrizAdj[origem][destino];
+    if (esparsa) {
+        if (origem == destino) {
+            return 0;
+        }
+        int k = posicaoCSR(origem, destino);
+        return k >= 0 ? custosCSR[k] : INFINITO;
+    }
+    return custos[posicao(origem, destino)];
 }
 
 double Grafo::getSolucaoOtima() const {
@@ -181,8 +432,421 @@ std::string Grafo::getNomeInstancia() const {
     return nomeInstancia;
 }
 
-const std::vector<std::vector<double>>& Grafo::getMatrizAdj() const {
-    return matrizAdj;
+bool Grafo::isSimetrica() const {
+    return simetrica;
+}
+
+bool Grafo::isEsparsa() const {
+    return esparsa;
+}
+
+// Copia a linha de custos de um vértice
+void Grafo::copiarLinha(int vertice, double* destino) const {
+    int n = numVertices;
+    if (esparsa) {
+        std::fill(destino, destino + n, INFINITO);
+        destino[vertice] = 0;
+        for (int k = inicioCSR[vertice]; k < inicioCSR[vertice + 1]; k++) {
+            destino[vizinhosCSR[k]] = custosCSR[k];
+        }
+        return;
+    }
+    if (!simetrica) {
+        std::memcpy(destino, &custos[inicioLinha[vertice]], n * sizeof(double));
+        return;
+    }
+    
+    // c(v, 0..v) é contíguo; c(v, j) para j > v está na coluna v das linhas seguintes
+    std::memcpy(destino, &custos[inicioLinha[vertice]], (vertice + 1) * sizeof(double));
+    for (int j = vertice + 1; j < n; j++) {
+        destino[j] = custos[inicioLinha[j] + vertice];
+    }
+}
+
+size_t Grafo::getBytesCustos() const {
+    return custos.size() * sizeof(double) + (inicioCSR.size() + vizinhosCSR.size()) * sizeof(int) +
+           custosCSR.size() * sizeof(double);
+}
+
+// Vizinhos em ordem de ID (adjacência esparsa calculada sob demanda)
+Vizinhanca Grafo::getVizinhos(int vertice) const {
+    if (!vizinhosValidos) {
+        prepararIndices();
+    }
+    int inicio = inicioAdjacencia[vertice];
+    return {adjacentes.data() + inicio, custosAdjacentes.data() + inicio, inicioAdjacencia[vertice + 1] - inicio};
+}
+
+// Vizinhos ordenados por custo (calculados sob demanda)
+const std::vector<int>& Grafo::getVizinhosOrdenados(int vertice) const {
+    if (!vizinhosValidos) {
+        prepararIndices();
+    }
+    return vizinhosOrdenados[vertice];
+}
+
+// Arestas ordenadas por custo (calculadas sob demanda)
+const std::vector<Aresta>& Grafo::getArestasOrdenadas() const {
+    if (!vizinhosValidos) {
+        prepararIndices();
+    }
+    return arestasOrdenadas;
+}
+
+void Grafo::prepararIndices() const {
+    if (vizinhosValidos) {
+        return;
+    }
+    
+    int n = numVertices;
+    inicioAdjacencia.clear();
+    adjacentes.clear();
+    custosAdjacentes.clear();
+    vizinhosOrdenados.assign(n, std::vector<int>());
+    arestasOrdenadas.clear();
+    
+    if (esparsa) {
+        // Adjacência das arestas da CSR que restam após a poda
+        inicioAdjacencia.assign(n + 1, 0);
+        adjacentes.reserve(vizinhosCSR.size());
+        custosAdjacentes.reserve(vizinhosCSR.size());
+        for (int i = 0; i < n; i++) {
+            for (int k = inicioCSR[i]; k < inicioCSR[i + 1]; k++) {
+                if (custosCSR[k] < INFINITO && (arestaEliminada.empty() || !arestaEliminada[k])) {
+                    adjacentes.push_back(vizinhosCSR[k]);
+                    custosAdjacentes.push_back(custosCSR[k]);
+                }
+            }
+            inicioAdjacencia[i + 1] = adjacentes.size();
+        }
+        
+        for (int i = 0; i < n; i++) {
+            int inicio = inicioAdjacencia[i];
+            const double* custosLinha = custosAdjacentes.data() + inicio;
+            std::vector<int> posicoes(inicioAdjacencia[i + 1] - inicio);
+            for (size_t k = 0; k < posicoes.size(); k++) {
+                posicoes[k] = k;
+            }
+            std::stable_sort(posicoes.begin(), posicoes.end(), [custosLinha](int a, int b) {
+                return custosLinha[a] < custosLinha[b];
+            });
+            std::vector<int>& lista = vizinhosOrdenados[i];
+            lista.reserve(posicoes.size());
+            for (int k : posicoes) {
+                lista.push_back(adjacentes[inicio + k]);
+            }
+        }
+        
+        for (int i = 0; i < n; i++) {
+            for (int k = inicioAdjacencia[i]; k < inicioAdjacencia[i + 1]; k++) {
+                if (adjacentes[k] > i) {
+                    arestasOrdenadas.push_back({i, adjacentes[k], custosAdjacentes[k]});
+                }
+            }
+        }
+    } else {
+        // Matriz: índices lidos direto das linhas; uma cópia da adjacência
+        // ocuparia n² posições e desfaria a compactação triangular
+        std::vector<double> linha(n);
+        for (int i = 0; i < n; i++) {
+            copiarLinha(i, linha.data());
+            std::vector<int>& lista = vizinhosOrdenados[i];
+            lista.reserve(n - 1);
+            for (int j = 0; j < n; j++) {
+                if (existeAresta(i, j)) {
+                    lista.push_back(j);
+                }
+            }
+            std::stable_sort(lista.begin(), lista.end(), [&linha](int a, int b) {
+                return linha[a] < linha[b];
+            });
+        }
+        
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                if (existeAresta(i, j)) {
+                    arestasOrdenadas.push_back({i, j, getCusto(i, j)});
+                }
+            }
+        }
+    }
+    std::stable_sort(arestasOrdenadas.begin(), arestasOrdenadas.end(), [](const Aresta& a, const Aresta& b) {
+        return a.custo < b.custo;
+    });
+    vizinhosValidos = true;
+}
+
+// Poda de arestas por dominância
+int Grafo::aplicarPoda() {
+    podaAtiva = true;
+    arestaEliminada.clear();  // Força a invalidação dos índices
+    atualizarPoda();
+    return numArestasEliminadas;
+}
+
+void Grafo::atualizarPoda() {
+    if (!podaAtiva) {
+        return;
+    }
+    
+    int n = numVertices;
+    std::vector<bool> mascara(esparsa ? vizinhosCSR.size() : custos.size(), false);
+    numArestasEliminadas = 0;
+    numArestasTotal = 0;
+    
+    // Instância esparsa: cada par é visto pela sua aresta de menor origem, e a
+    // máscara marca as duas direções pela posição em vizinhosCSR
+    for (int i = 0; i < n && esparsa; i++) {
+        for (int k = inicioCSR[i]; k < inicioCSR[i + 1]; k++) {
+            int j = vizinhosCSR[k];
+            int reversa = posicaoCSR(j, i);
+            if (j < i && reversa >= 0) continue;
+            double cij = custosCSR[k];
+            double cji = reversa >= 0 ? custosCSR[reversa] : INFINITO;
+            if (cij == INFINITO && cji == INFINITO) continue;
+            numArestasTotal++;
+            if (i == raiz || j == raiz) continue;
+            
+            bool eliminar = demandas[i] + demandas[j] > capacidade;
+            if (!eliminar) {
+                eliminar = std::min(cij, cji) > std::max(getCusto(i, raiz), getCusto(j, raiz));
+            }
+            if (eliminar) {
+                mascara[k] = true;
+                if (reversa >= 0) mascara[reversa] = true;
+                numArestasEliminadas++;
+            }
+        }
+    }
+    
+    for (int i = 0; i < n && !esparsa; i++) {
+        for (int j = i + 1; j < n; j++) {
+            double cij = getCusto(i, j);
+            double cji = getCusto(j, i);
+            if (cij == INFINITO && cji == INFINITO) continue;
+            numArestasTotal++;
+            if (i == raiz || j == raiz) continue;
+            
+            bool eliminar = demandas[i] + demandas[j] > capacidade;
+            if (!eliminar) {
+                eliminar = std::min(cij, cji) > std::max(getCusto(i, raiz), getCusto(j, raiz));
+            }
+            if (eliminar) {
+                mascara[posicao(i, j)] = true;  // Na triangular, a mesma posição de (j, i)
+                mascara[posicao(j, i)] = true;
+                numArestasEliminadas++;
+            }
+        }
+    }
+    
+    if (mascara != arestaEliminada) {
+        arestaEliminada.swap(mascara);
+        invalidarIndices();
+    }
+}
+
+int Grafo::getNumArestasEliminadas() const {
+    return numArestasEliminadas;
+}
+
+int Grafo::getNumArestasTotal() const {
+    return numArestasTotal;
+}
+
+void Grafo::invalidarIndices() {
+    vizinhosValidos = false;
+    vizinhosOrdenados.clear();
+    arestasOrdenadas.clear();
+    inicioAdjacencia.clear();
+    adjacentes.clear();
+    custosAdjacentes.clear();
+}
+
+// Hash FNV-1a do conteúdo da instância
+uint64_t Grafo::hashConteudo() const {
+    uint64_t hash = 1469598103934665603ULL;
+    auto misturar = [&hash](const void* dados, size_t tamanho) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(dados);
+        for (size_t i = 0; i < tamanho; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    
+    int raizOriginal = getIdOriginal(raiz);
+    misturar(&numVertices, sizeof(numVertices));
+    misturar(&raizOriginal, sizeof(raizOriginal));
+    
+    for (int i = 0; i < numVertices; i++) {
+        int d = getDemanda(getIdInterno(i));
+        misturar(&d, sizeof(d));
+    }
+    // Instância esparsa: as arestas de cada vértice, em ordem de ID original
+    for (int i = 0; i < numVertices && esparsa; i++) {
+        int v = getIdInterno(i);
+        std::vector<std::pair<int, double>> arestas;
+        for (int k = inicioCSR[v]; k < inicioCSR[v + 1]; k++) {
+            arestas.push_back({getIdOriginal(vizinhosCSR[k]), custosCSR[k]});
+        }
+        std::sort(arestas.begin(), arestas.end());
+        int grau = arestas.size();
+        misturar(&grau, sizeof(grau));
+        for (const auto& a : arestas) {
+            misturar(&a.first, sizeof(a.first));
+            misturar(&a.second, sizeof(a.second));
+        }
+    }
+    for (int i = 0; i < numVertices && !esparsa; i++) {
+        for (int j = 0; j < numVertices; j++) {
+            double c = getCusto(getIdInterno(i), getIdInterno(j));
+            misturar(&c, sizeof(c));
+        }
+    }
+    
+    return hash;
+}
+
+// Renumeração interna dos vértices
+void Grafo::renumerar(const std::vector<int>& ordem) {
+    int n = numVertices;
+    if ((int)ordem.size() != n || ordem.empty() || ordem[0] != raiz) {
+        return;
+    }
+    
+    std::vector<int> novasDemandas(n);
+    std::vector<int> novosIds(n);
+    for (int a = 0; a < n; a++) {
+        novasDemandas[a] = demandas[ordem[a]];
+        novosIds[a] = getIdOriginal(ordem[a]);
+    }
+    
+    if (esparsa) {
+        std::vector<int> novaPosicao(n);
+        for (int a = 0; a < n; a++) {
+            novaPosicao[ordem[a]] = a;
+        }
+        std::vector<std::vector<std::pair<int, double>>> listas(n);
+        for (int a = 0; a < n; a++) {
+            for (int k = inicioCSR[ordem[a]]; k < inicioCSR[ordem[a] + 1]; k++) {
+                listas[a].push_back({novaPosicao[vizinhosCSR[k]], custosCSR[k]});
+            }
+        }
+        montarCSR(listas);
+    } else {
+        std::vector<double> completa((size_t)n * n);
+        std::vector<double> linha(n);
+        for (int a = 0; a < n; a++) {
+            copiarLinha(ordem[a], linha.data());
+            for (int b = 0; b < n; b++) {
+                completa[(size_t)a * n + b] = linha[ordem[b]];
+            }
+        }
+        montarArmazenamento(completa);
+    }
+    
+    demandas.swap(novasDemandas);
+    idOriginal.swap(novosIds);
+    idInterno.assign(n, -1);
+    for (int v = 0; v < n; v++) {
+        idInterno[idOriginal[v]] = v;
+    }
+    raiz = 0;
+    
+    invalidarIndices();
+    arestaEliminada.clear();
+    atualizarPoda();
+}
+
+// Ordem por custo de ligação à raiz
+std::vector<int> Grafo::ordemPorRaiz() const {
+    std::vector<int> ordem;
+    ordem.reserve(numVertices);
+    for (int v = 0; v < numVertices; v++) {
+        if (v != raiz) ordem.push_back(v);
+    }
+    std::stable_sort(ordem.begin(), ordem.end(), [this](int a, int b) {
+        return getCusto(a, raiz) < getCusto(b, raiz);
+    });
+    ordem.insert(ordem.begin(), raiz);
+    return ordem;
+}
+
+// Ordem de Cuthill-McKee no grafo dos k vizinhos mais próximos
+std::vector<int> Grafo::ordemCuthillMcKee(int k) const {
+    int n = numVertices;
+    
+    // Grafo k-NN simetrizado
+    std::vector<std::vector<int>> adjacentes(n);
+    for (int v = 0; v < n; v++) {
+        const std::vector<int>& vizinhos = getVizinhosOrdenados(v);
+        for (int i = 0; i < k && i < (int)vizinhos.size(); i++) {
+            adjacentes[v].push_back(vizinhos[i]);
+            adjacentes[vizinhos[i]].push_back(v);
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        std::sort(adjacentes[v].begin(), adjacentes[v].end());
+        adjacentes[v].erase(std::unique(adjacentes[v].begin(), adjacentes[v].end()), adjacentes[v].end());
+    }
+    
+    // Busca em largura a partir da raiz; componentes desconexos recomeçam pelo
+    // vértice não visitado mais próximo da raiz. A raiz precisa ficar em 0, por
+    // isso a ordem não é invertida (a largura de banda é a mesma do RCM)
+    std::vector<int> ordem;
+    ordem.reserve(n);
+    std::vector<char> visitado(n, 0);
+    std::vector<int> porRaiz = ordemPorRaiz();
+    for (int inicio : porRaiz) {
+        if (visitado[inicio]) continue;
+        visitado[inicio] = 1;
+        size_t cabeca = ordem.size();
+        ordem.push_back(inicio);
+        for (; cabeca < ordem.size(); cabeca++) {
+            int v = ordem[cabeca];
+            std::vector<int> novos;
+            for (int u : adjacentes[v]) {
+                if (!visitado[u]) {
+                    visitado[u] = 1;
+                    novos.push_back(u);
+                }
+            }
+            std::stable_sort(novos.begin(), novos.end(), [&adjacentes](int a, int b) {
+                return adjacentes[a].size() < adjacentes[b].size();
+            });
+            ordem.insert(ordem.end(), novos.begin(), novos.end());
+        }
+    }
+    return ordem;
+}
+
+int Grafo::getIdOriginal(int vertice) const {
+    return idOriginal.empty() ? vertice : idOriginal[vertice];
+}
+
+int Grafo::getIdInterno(int original) const {
+    return idInterno.empty() ? original : idInterno[original];
+}
+
+std::vector<int> Grafo::paisParaOriginal(const std::vector<int>& pais) const {
+    if (idOriginal.empty()) {
+        return pais;
+    }
+    std::vector<int> convertidos(pais.size(), -1);
+    for (size_t v = 0; v < pais.size() && v < idOriginal.size(); v++) {
+        convertidos[idOriginal[v]] = pais[v] >= 0 ? idOriginal[pais[v]] : -1;
+    }
+    return convertidos;
+}
+
+std::vector<int> Grafo::paisParaInterno(const std::vector<int>& pais) const {
+    if (idInterno.empty()) {
+        return pais;
+    }
+    std::vector<int> convertidos(pais.size(), -1);
+    for (size_t o = 0; o < pais.size() && o < idInterno.size(); o++) {
+        convertidos[idInterno[o]] = (pais[o] >= 0 && pais[o] < (int)idInterno.size()) ? idInterno[pais[o]] : -1;
+    }
+    return convertidos;
 }
 
 // Setters
@@ -195,13 +859,102 @@ void Grafo::setRaiz(int r) {
 void Grafo::setDemanda(int vertice, int demanda) {
     if (vertice >= 0 && vertice < numVertices && demanda >= 0) {
         demandas[vertice] = demanda;
+        atualizarPoda();
+    }
+}
+
+void Grafo::setCapacidade(int cap) {
+    if (cap > 0) {
+        capacidade = cap;
+        atualizarPoda();
     }
 }
 
 void Grafo::setCusto(int origem, int destino, double custo) {
     if (origem >= 0 && origem < numVertices && destino >= 0 && destino < numVertices) {
-        matrizAdj[origem][destino] = custo;
+        if (esparsa) {
+            if (origem == destino) return;
+            if (custo != getCusto(destino, origem)) simetrica = false;
+            definirCustoCSR(origem, destino, custo);
+        } else {
+            if (simetrica && origem != destino && custo != getCusto(destino, origem)) {
+                expandirParaCompleta();
+            }
+            custos[posicao(origem, destino)] = custo;
+        }
+        invalidarIndices();
+        atualizarPoda();
+    }
+}
+
+void Grafo::setCustoSimetrico(int i, int j, double custo) {
+    if (i >= 0 && i < numVertices && j >= 0 && j < numVertices) {
+        if (esparsa) {
+            if (i == j) return;
+            definirCustoCSR(i, j, custo);
+            definirCustoCSR(j, i, custo);
+        } else {
+            custos[posicao(i, j)] = custo;
+            custos[posicao(j, i)] = custo;
+        }
+        invalidarIndices();
+        atualizarPoda();
+    }
+}
+
+// Acrescenta um novo vértice
+int Grafo::adicionarVertice(const std::vector<double>& custosVertice, int demanda) {
+    int novo = numVertices;
+    
+    if (esparsa) {
+        // Arestas só para os custos finitos
+        std::vector<std::vector<std::pair<int, double>>> listas(novo + 1);
+        for (int v = 0; v < novo; v++) {
+            for (int k = inicioCSR[v]; k < inicioCSR[v + 1]; k++) {
+                listas[v].push_back({vizinhosCSR[k], custosCSR[k]});
+            }
+        }
+        for (int i = 0; i < novo && i < (int)custosVertice.size(); i++) {
+            if (custosVertice[i] < INFINITO) {
+                listas[i].push_back({novo, custosVertice[i]});
+                listas[novo].push_back({i, custosVertice[i]});
+            }
+        }
+        numVertices++;
+        montarCSR(listas);
+    } else if (simetrica) {
+        // Nova linha compactada ao final: c(novo, 0..novo)
+        inicioLinha.push_back(custos.size());
+        custos.resize(custos.size() + alinharLinha(novo + 1), INFINITO);
+        numVertices++;
+        for (int i = 0; i < novo; i++) {
+            custos[inicioLinha[novo] + i] = (i < (int)custosVertice.size()) ? custosVertice[i] : INFINITO;
+        }
+    } else {
+        std::vector<double> completa((size_t)(novo + 1) * (novo + 1), INFINITO);
+        for (int i = 0; i < novo; i++) {
+            copiarLinha(i, &completa[(size_t)i * (novo + 1)]);
+        }
+        numVertices++;
+        for (int i = 0; i < novo; i++) {
+            double c = (i < (int)custosVertice.size()) ? custosVertice[i] : INFINITO;
+            completa[(size_t)i * numVertices + novo] = c;
+            completa[(size_t)novo * numVertices + i] = c;
+        }
+        montarArmazenamento(completa);
     }
+    if (!esparsa) {
+        custos[posicao(novo, novo)] = 0;
+    }
+    demandas.push_back(demanda >= 0 ? demanda : 1);
+    if (!idOriginal.empty()) {
+        idOriginal.push_back(novo);
+        idInterno.push_back(novo);
+    }
+    
+    invalidarIndices();
+    atualizarPoda();
+    return novo;
 }
 
 // Verifica se existe aresta
@@ -209,7 +962,15 @@ bool Grafo::existeAresta(int origem, int destino) const {
     if (origem < 0 || origem >= numVertices || destino < 0 || destino >= numVertices) {
         return false;
     }
-    return matrizAdj[origem][destino] < INFINITO && origem != destino;
+    if (esparsa) {
+        int k = (origem != destino) ? posicaoCSR(origem, destino) : -1;
+        return k >= 0 && custosCSR[k] < INFINITO && (arestaEliminada.empty() || !arestaEliminada[k]);
+    }
+    size_t p = posicao(origem, destino);
+    if (!arestaEliminada.empty() && arestaEliminada[p]) {
+        return false;
+    }
+    return custos[p] < INFINITO && origem != destino;
 }
 
 // Imprime informações do grafo
@@ -218,7 +979,14 @@ void Grafo::imprimir() const {
     std::cout << "Instância: " << nomeInstancia << std::endl;
     std::cout << "Vértices: " << numVertices << std::endl;
     std::cout << "Capacidade: " << capacidade << std::endl;
-    std::cout << "Raiz: " << raiz << std::endl;
+    std::cout << "Raiz: " << getIdOriginal(raiz) << std::endl;
+    if (esparsa) {
+        std::cout << "Custos: lista de arestas esparsa, " << vizinhosCSR.size() << " arestas direcionadas"
+                  << " (" << getBytesCustos() / 1024 << " KiB)" << std::endl;
+    } else {
+        std::cout << "Matriz de custos: " << (simetrica ? "simétrica, triangular compactada" : "completa")
+                  << " (" << getBytesCustos() / 1024 << " KiB)" << std::endl;
+    }
     if (solucaoOtima > 0) {
         std::cout << "Solução ótima conhecida: " << solucaoOtima << std::endl;
     }
@@ -229,7 +997,7 @@ void Grafo::imprimir() const {
     for (int i = 0; i < numVertices && count < 10; i++) {
         for (int j = i + 1; j < numVertices && count < 10; j++) {
             if (existeAresta(i, j)) {
-                std::cout << "  " << i << " -- " << j << " [custo=" << matrizAdj[i][j] << "]" << std::endl;
+                std::cout << "  " << getIdOriginal(i) << " -- " << getIdOriginal(j) << " [custo=" << getCusto(i, j) << "]" << std::endl;
                 count++;
             }
         }
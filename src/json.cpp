@@ -0,0 +1,213 @@
+#include "../includes/json.h"
+#include <cstdlib>
+#include <cstring>
+
+ValorJSON::ValorJSON() : tipo(NULO), booleano(false), numero(0) {}
+
+// Analisador descendente recursivo sobre o texto de entrada
+namespace {
+    struct Leitor {
+        const std::string& s;
+        size_t pos;
+        std::string erro;
+        int profundidade;
+
+        Leitor(const std::string& entrada) : s(entrada), pos(0), profundidade(0) {}
+
+        bool falhar(const std::string& mensagem) {
+            if (erro.empty()) {
+                erro = mensagem + " (posição " + std::to_string(pos) + ")";
+            }
+            return false;
+        }
+
+        void pularEspacos() {
+            while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\n' || s[pos] == '\r')) {
+                pos++;
+            }
+        }
+
+        bool literal(const char* palavra) {
+            size_t k = std::strlen(palavra);
+            if (s.compare(pos, k, palavra) != 0) {
+                return falhar("valor inválido");
+            }
+            pos += k;
+            return true;
+        }
+
+        // Acrescenta o código Unicode em UTF-8
+        static void anexarUTF8(std::string& saida, unsigned int c) {
+            if (c < 0x80) {
+                saida += (char)c;
+            } else if (c < 0x800) {
+                saida += (char)(0xC0 | (c >> 6));
+                saida += (char)(0x80 | (c & 0x3F));
+            } else {
+                saida += (char)(0xE0 | (c >> 12));
+                saida += (char)(0x80 | ((c >> 6) & 0x3F));
+                saida += (char)(0x80 | (c & 0x3F));
+            }
+        }
+
+        bool lerTexto(std::string& saida) {
+            pos++;  // Aspas iniciais
+            while (pos < s.size() && s[pos] != '"') {
+                char c = s[pos++];
+                if (c != '\\') {
+                    saida += c;
+                    continue;
+                }
+                if (pos >= s.size()) break;
+                char e = s[pos++];
+                switch (e) {
+                    case '"': saida += '"'; break;
+                    case '\\': saida += '\\'; break;
+                    case '/': saida += '/'; break;
+                    case 'b': saida += '\b'; break;
+                    case 'f': saida += '\f'; break;
+                    case 'n': saida += '\n'; break;
+                    case 'r': saida += '\r'; break;
+                    case 't': saida += '\t'; break;
+                    case 'u': {
+                        if (pos + 4 > s.size()) return falhar("escape \\u incompleto");
+                        anexarUTF8(saida, (unsigned int)std::strtoul(s.substr(pos, 4).c_str(), nullptr, 16));
+                        pos += 4;
+                        break;
+                    }
+                    default: return falhar("escape inválido");
+                }
+            }
+            if (pos >= s.size()) {
+                return falhar("texto sem aspas finais");
+            }
+            pos++;  // Aspas finais
+            return true;
+        }
+
+        bool lerValor(ValorJSON& v) {
+            if (++profundidade > 64) {
+                return falhar("aninhamento excessivo");
+            }
+            pularEspacos();
+            if (pos >= s.size()) {
+                return falhar("fim inesperado");
+            }
+
+            bool ok = true;
+            char c = s[pos];
+            if (c == '{') {
+                v.tipo = ValorJSON::OBJETO;
+                pos++;
+                pularEspacos();
+                if (pos < s.size() && s[pos] == '}') {
+                    pos++;
+                } else {
+                    while (ok) {
+                        pularEspacos();
+                        std::string chave;
+                        if (pos >= s.size() || s[pos] != '"') return falhar("chave esperada");
+                        if (!lerTexto(chave)) return false;
+                        pularEspacos();
+                        if (pos >= s.size() || s[pos] != ':') return falhar("':' esperado");
+                        pos++;
+                        ok = lerValor(v.objeto[chave]);
+                        pularEspacos();
+                        if (ok && pos < s.size() && s[pos] == ',') {
+                            pos++;
+                        } else if (ok && pos < s.size() && s[pos] == '}') {
+                            pos++;
+                            break;
+                        } else if (ok) {
+                            return falhar("',' ou '}' esperado");
+                        }
+                    }
+                }
+            } else if (c == '[') {
+                v.tipo = ValorJSON::LISTA;
+                pos++;
+                pularEspacos();
+                if (pos < s.size() && s[pos] == ']') {
+                    pos++;
+                } else {
+                    while (ok) {
+                        v.lista.emplace_back();
+                        ok = lerValor(v.lista.back());
+                        pularEspacos();
+                        if (ok && pos < s.size() && s[pos] == ',') {
+                            pos++;
+                        } else if (ok && pos < s.size() && s[pos] == ']') {
+                            pos++;
+                            break;
+                        } else if (ok) {
+                            return falhar("',' ou ']' esperado");
+                        }
+                    }
+                }
+            } else if (c == '"') {
+                v.tipo = ValorJSON::TEXTO;
+                ok = lerTexto(v.texto);
+            } else if (c == 't') {
+                v.tipo = ValorJSON::BOOLEANO;
+                v.booleano = true;
+                ok = literal("true");
+            } else if (c == 'f') {
+                v.tipo = ValorJSON::BOOLEANO;
+                ok = literal("false");
+            } else if (c == 'n') {
+                ok = literal("null");
+            } else {
+                const char* inicio = s.c_str() + pos;
+                char* fim = nullptr;
+                v.tipo = ValorJSON::NUMERO;
+                v.numero = std::strtod(inicio, &fim);
+                if (fim == inicio) {
+                    return falhar("valor inválido");
+                }
+                pos += fim - inicio;
+            }
+
+            profundidade--;
+            return ok;
+        }
+    };
+}
+
+// Lê um documento JSON completo
+bool ValorJSON::parsear(const std::string& entrada, std::string& erro) {
+    *this = ValorJSON();
+    Leitor leitor(entrada);
+    bool ok = leitor.lerValor(*this);
+    if (ok) {
+        leitor.pularEspacos();
+        if (leitor.pos != entrada.size()) {
+            ok = leitor.falhar("conteúdo após o fim do documento");
+        }
+    }
+    erro = leitor.erro;
+    return ok;
+}
+
+// Retorna o membro do objeto
+const ValorJSON* ValorJSON::membro(const std::string& chave) const {
+    if (tipo != OBJETO) {
+        return nullptr;
+    }
+    auto it = objeto.find(chave);
+    return it != objeto.end() ? &it->second : nullptr;
+}
+
+double ValorJSON::numeroOu(const std::string& chave, double padrao) const {
+    const ValorJSON* v = membro(chave);
+    return (v != nullptr && v->tipo == NUMERO) ? v->numero : padrao;
+}
+
+std::string ValorJSON::textoOu(const std::string& chave, const std::string& padrao) const {
+    const ValorJSON* v = membro(chave);
+    return (v != nullptr && v->tipo == TEXTO) ? v->texto : padrao;
+}
+
+bool ValorJSON::booleanoOu(const std::string& chave, bool padrao) const {
+    const ValorJSON* v = membro(chave);
+    return (v != nullptr && v->tipo == BOOLEANO) ? v->booleano : padrao;
+}
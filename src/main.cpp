@@ -3,44 +3,144 @@
 #include <vector>
 #include <sstream>
 #include <cstring>
+#include <memory>
+#include <algorithm>
 #include "../includes/grafo.h"
 #include "../includes/solucao.h"
 #include "../includes/algoritmos.h"
 #include "../includes/utils.h"
+#include "../includes/repositorio.h"
+#include "../includes/cmst.h"
+#include "../includes/servidor.h"
+#include "../includes/trace.h"
+#include "../includes/sintonia.h"
+#include "../includes/comparacao.h"
+#include <iomanip>
+#include <fstream>
 
 // Nome do arquivo CSV de resultados
 const std::string ARQUIVO_CSV = "resultados.csv";
 
+// Diretório padrão do repositório de soluções (warm start)
+const std::string DIRETORIO_WARM = ".cmst_warm";
+
 /**
  * Imprime ajuda de uso do programa
  */
 void imprimirAjuda(const char* nomePrograma) {
-    std::cout << "Uso: " << nomePrograma << " <instancia> <algoritmo> [opcoes]\n\n";
+    std::cout << "Uso: " << nomePrograma << " <instancia> <algoritmo> [opcoes]\n";
+    std::cout << "     " << nomePrograma << " serve --socket <caminho> [--threads <num>] [--verbose]\n";
+    std::cout << "     " << nomePrograma << " trace2csv <trace> [saida.csv]\n";
+    std::cout << "     " << nomePrograma << " tune <instancia> [<instancia> ...] [opcoes]\n";
+    std::cout << "     " << nomePrograma << " compare <a.csv> <b.csv> [--nivel <valor>] [--tolerancia-tempo <valor>]\n\n";
     std::cout << "Algoritmos disponíveis:\n";
     std::cout << "  guloso       - Algoritmo guloso determinístico\n";
     std::cout << "  randomizado  - Algoritmo guloso randomizado\n";
-    std::cout << "  reativo      - Algoritmo guloso randomizado reativo\n\n";
+    std::cout << "  reativo      - Algoritmo guloso randomizado reativo\n";
+    std::cout << "  lns          - Busca em vizinhança ampla (ruína e reconstrução)\n";
+    std::cout << "  tabu         - Busca tabu com penalidade adaptativa de capacidade\n";
+    std::cout << "  reotimizar   - Re-otimização incremental após alterações na instância\n\n";
     
     std::cout << "Opções para 'randomizado':\n";
     std::cout << "  --alpha <valor>   - Valor de alpha (0.0 a 1.0), default: 0.3\n";
     std::cout << "  --iter <num>      - Número de iterações, default: 30\n";
-    std::cout << "  --seed <num>      - Semente de randomização (opcional)\n\n";
+    std::cout << "  --seed <num>      - Semente de randomização (opcional)\n";
+    std::cout << "  --abandono        - Interrompe as construções que não podem superar a\n";
+    std::cout << "                      incumbente (também no reativo), default: desligado\n";
+    std::cout << "  --recombinar <num> - Guarda as subárvores das construções e, a cada <num>\n";
+    std::cout << "                      iterações e ao final, recombina-as por particionamento\n";
+    std::cout << "                      de conjuntos (também no reativo), default: desligado\n\n";
     
     std::cout << "Opções para 'reativo':\n";
     std::cout << "  --alphas <lista>  - Lista de alphas separados por vírgula, default: 0.1,0.3,0.5\n";
     std::cout << "  --iter <num>      - Número de iterações, default: 300\n";
     std::cout << "  --bloco <num>     - Tamanho do bloco, default: 30\n";
+    std::cout << "  --seed <num>      - Semente de randomização (opcional)\n";
+    std::cout << "  --alpha-policy <p> - Seleção de alpha: roleta (probabilidades por bloco), ucb1\n";
+    std::cout << "                      ou thompson (bandidos atualizados a cada iteração), default: roleta\n";
+    std::cout << "  --alpha-faixa <a,b> - Faixa contínua de alpha no lugar de --alphas, dividida em\n";
+    std::cout << "                      braços; o alpha é sorteado dentro do braço escolhido\n";
+    std::cout << "  --bracos <num>    - Número de braços da faixa contínua, default: 8\n";
+    std::cout << "  --ilhas <num>     - Modelo de ilhas: um reativo por thread, com migração da\n";
+    std::cout << "                      elite e das probabilidades em anel, default: 1 (desligado)\n";
+    std::cout << "  --migracao <num>  - Iterações de cada ilha entre migrações, default: --bloco\n";
+    std::cout << "  --checkpoint <arq>           - Grava checkpoints periódicos da busca\n";
+    std::cout << "  --checkpoint-intervalo <num> - Iterações entre checkpoints, default: 50\n";
+    std::cout << "  --resume                     - Continua do checkpoint (resultado idêntico)\n";
+    std::cout << "  --trace <arq>     - Trace binário de cada iteração (também no randomizado);\n";
+    std::cout << "                      converta com '" << nomePrograma << " trace2csv <arq>'\n\n";
+    
+    std::cout << "Opções para 'lns':\n";
+    std::cout << "  --alpha <valor>   - Alpha da reinserção, default: 0.02\n";
+    std::cout << "  --iter <num>      - Número de iterações, default: 500\n";
+    std::cout << "  --remocao <frac>  - Fração de vértices removida por iteração, default: 0.1\n";
     std::cout << "  --seed <num>      - Semente de randomização (opcional)\n\n";
     
+    std::cout << "Opções para 'tabu':\n";
+    std::cout << "  --iter <num>      - Número máximo de iterações, default: 5000\n";
+    std::cout << "  --tempo <seg>     - Limite de tempo em segundos, default: 10\n\n";
+    
+    std::cout << "Opções para 'reotimizar':\n";
+    std::cout << "  --edicoes <arq>   - Arquivo de alterações (custo/demanda/terminal), obrigatório\n";
+    std::cout << "  --iter <num>      - Iterações de refinamento por LNS, default: 20\n";
+    std::cout << "  (a solução base é a do --warm-start, se houver, ou a gulosa)\n\n";
+    
     std::cout << "Opções gerais:\n";
     std::cout << "  --csv <arquivo>   - Arquivo CSV de saída, default: resultados.csv\n";
+    std::cout << "  --jsonl <arquivo> - Também grava resultado, métricas e solução em JSON lines\n";
+    std::cout << "  --lock            - Usa flock() ao gravar (várias execuções no mesmo arquivo)\n";
+    std::cout << "  --construtor <c>  - Motor construtivo: prim (inserção gulosa) ou kruskal\n";
+    std::cout << "                      (union-find capacitado), default: prim\n";
+    std::cout << "  --capacidades <l> - Resolve cada Q da lista (ex.: 3,5,10), partindo da solução\n";
+    std::cout << "                      do Q anterior; uma linha do CSV por capacidade\n";
+    std::cout << "  --warm-start      - Parte da melhor solução conhecida e grava melhorias\n";
+    std::cout << "  --warm-dir <dir>  - Diretório do repositório de soluções, default: .cmst_warm\n";
+    std::cout << "  --renumerar <m>   - Renumeração interna para localidade: raiz (custo até a\n";
+    std::cout << "                      raiz) ou rcm (Cuthill-McKee nos 10 vizinhos mais próximos)\n";
+    std::cout << "  --troca-ciclica   - Pós-processa a solução com a vizinhança de troca cíclica\n";
+    std::cout << "                      entre subárvores (Ahuja-Orlin-Sharma)\n";
+    std::cout << "  --poda            - Elimina no carregamento as arestas que não estão em nenhuma\n";
+    std::cout << "                      solução ótima (relata a fração podada)\n";
     std::cout << "  --verbose         - Modo verboso (imprime detalhes)\n";
     std::cout << "  --help            - Mostra esta ajuda\n\n";
     
+    std::cout << "Modo servidor ('serve'):\n";
+    std::cout << "  --socket <arq>    - Socket Unix onde os pedidos (JSON lines) são recebidos\n";
+    std::cout << "  --threads <num>   - Threads de solução, default: núcleos disponíveis\n";
+    std::cout << "  (instâncias ficam em memória; encerre com {\"op\":\"encerrar\"} ou SIGTERM)\n\n";
+    
+    std::cout << "Sintonia do reativo por corrida ('tune'):\n";
+    std::cout << "  --alphas-candidatos <l> - Conjuntos de alphas separados por ';', default:\n";
+    std::cout << "                      \"0.1,0.3,0.5;0.05,0.1,0.2;0.1,0.2,0.3,0.4,0.5;0.2,0.4,0.6\"\n";
+    std::cout << "  --blocos <lista>  - Tamanhos de bloco candidatos, default: 10,30,50\n";
+    std::cout << "  --iters <lista>   - Números de iterações candidatos, default: 100,300,500\n";
+    std::cout << "  --sementes <num>  - Sementes por instância, default: 10\n";
+    std::cout << "  --blocos-minimos <num> - Blocos antes do primeiro teste de Friedman, default: 5\n";
+    std::cout << "  --nivel <valor>   - Nível de significância das eliminações, default: 0.05\n";
+    std::cout << "  --orcamento <num> - Máximo de execuções por classe, default: sem limite\n";
+    std::cout << "  --threads <num>   - Execuções simultâneas, default: núcleos disponíveis\n";
+    std::cout << "  --seed <num>      - Primeira semente dos blocos, default: 1\n\n";
+    
+    std::cout << "Comparação A/B de resultados ('compare'):\n";
+    std::cout << "  Pareia as execuções por instância, algoritmo, configuração e semente e testa as\n";
+    std::cout << "  diferenças de custo e de tempo (B - A) por Wilcoxon; código de saída 2 se houver regressão.\n";
+    std::cout << "  A configuração inclui Q, alpha, iterações, bloco, construtor, politica_alpha e opcoes;\n";
+    std::cout << "  colunas ausentes em um dos CSVs (versão anterior) ficam fora da chave\n";
+    std::cout << "  --nivel <valor>   - Nível de significância, default: 0.05\n";
+    std::cout << "  --tolerancia-tempo <valor> - Variação relativa de tempo tolerada, default: 0.05\n\n";
+    
+    std::cout << "Conversão de trace ('trace2csv'):\n";
+    std::cout << "  Converte o trace de --trace em CSV (saída padrão se o arquivo for omitido)\n\n";
+    
     std::cout << "Exemplos:\n";
     std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT guloso\n";
     std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT randomizado --alpha 0.3 --iter 30\n";
     std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT reativo --alphas 0.1,0.2,0.3 --iter 300 --bloco 30\n";
+    std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT reativo --alpha-policy thompson --alpha-faixa 0,0.5\n";
+    std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT reativo --iter 2000 --ilhas 4\n";
+    std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT lns --iter 500 --remocao 0.1\n";
+    std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT tabu --iter 5000 --tempo 10\n";
+    std::cout << "  " << nomePrograma << " capmstnew/TC4001.DAT lns --capacidades 3,5,10,20\n";
 }
 
 /**
@@ -65,7 +165,354 @@ std::vector<double> parsearAlphas(const std::string& str) {
     return alphas;
 }
 
+/**
+ * Parseia uma string de capacidades separadas por vírgula
+ */
+std::vector<int> parsearCapacidades(const std::string& str) {
+    std::vector<int> capacidades;
+    std::stringstream ss(str);
+    std::string item;
+    
+    while (std::getline(ss, item, ',')) {
+        try {
+            int q = std::stoi(item);
+            if (q > 0) {
+                capacidades.push_back(q);
+            }
+        } catch (...) {
+            // Ignorar valores inválidos
+        }
+    }
+    
+    return capacidades;
+}
+
+/**
+ * Acrescenta uma opção à lista separada por espaço da coluna 'opcoes' do CSV
+ */
+void acrescentarOpcao(std::string& opcoes, const std::string& opcao) {
+    if (opcao.empty()) return;
+    if (!opcoes.empty()) opcoes += " ";
+    opcoes += opcao;
+}
+
+/**
+ * Sintonia por corrida: cmst tune <instancia> [<instancia> ...] [opcoes]
+ * @return Código de saída do programa
+ */
+int executarSintonia(int argc, char* argv[]) {
+    OpcoesSintonia opcoes;
+    std::vector<std::vector<double>> conjuntosAlphas;
+    std::vector<int> blocos = {10, 30, 50};
+    std::vector<int> iteracoes = {100, 300, 500};
+    
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--alphas-candidatos") == 0 && i + 1 < argc) {
+            std::stringstream ss(argv[++i]);
+            std::string conjunto;
+            while (std::getline(ss, conjunto, ';')) {
+                std::vector<double> alphas = parsearAlphas(conjunto);
+                if (!alphas.empty()) {
+                    conjuntosAlphas.push_back(alphas);
+                }
+            }
+        } else if (strcmp(argv[i], "--blocos") == 0 && i + 1 < argc) {
+            blocos = parsearCapacidades(argv[++i]);  // Lista de inteiros positivos
+        } else if (strcmp(argv[i], "--iters") == 0 && i + 1 < argc) {
+            iteracoes = parsearCapacidades(argv[++i]);
+        } else if (strcmp(argv[i], "--sementes") == 0 && i + 1 < argc) {
+            opcoes.numSementes = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--blocos-minimos") == 0 && i + 1 < argc) {
+            opcoes.blocosMinimos = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--nivel") == 0 && i + 1 < argc) {
+            opcoes.nivel = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--orcamento") == 0 && i + 1 < argc) {
+            opcoes.orcamento = std::stol(argv[++i]);
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            opcoes.numThreads = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            opcoes.sementeBase = std::stoul(argv[++i]);
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            opcoes.verbose = true;
+        } else if (strncmp(argv[i], "--", 2) != 0) {
+            opcoes.instancias.push_back(argv[i]);
+        }
+    }
+    
+    if (opcoes.instancias.empty() || blocos.empty() || iteracoes.empty() || opcoes.numSementes < 1) {
+        std::cerr << "Erro: 'tune' requer ao menos uma instância, blocos, iterações e sementes" << std::endl;
+        return 1;
+    }
+    if (conjuntosAlphas.empty()) {
+        conjuntosAlphas = {{0.1, 0.3, 0.5}, {0.05, 0.1, 0.2}, {0.1, 0.2, 0.3, 0.4, 0.5}, {0.2, 0.4, 0.6}};
+    }
+    opcoes.candidatas = Sintonia::montarGrade(conjuntosAlphas, blocos, iteracoes);
+    
+    std::cout << "Sintonia por corrida: " << opcoes.candidatas.size() << " configurações, "
+              << opcoes.instancias.size() << " instância(s), " << opcoes.numSementes << " semente(s)" << std::endl;
+    
+    Cronometro crono;
+    crono.iniciar();
+    std::string erro;
+    std::vector<ResultadoSintonia> resultados = Sintonia::executar(opcoes, erro);
+    if (!erro.empty()) {
+        std::cerr << erro << std::endl;
+        return 1;
+    }
+    crono.parar();
+    
+    for (const ResultadoSintonia& r : resultados) {
+        std::cout << "\n=== Classe " << r.classe << " (" << r.numInstancias << " instância(s)) ===" << std::endl;
+        std::cout << "Blocos avaliados: " << r.blocosAvaliados << " de " << r.blocosTotais << std::endl;
+        std::cout << "Execuções: " << r.execucoes << " (grade completa: " << r.execucoesGrade << ", "
+                  << Utils::formatarDouble(100.0 * r.execucoes / std::max(1L, r.execucoesGrade), 1) << "%)" << std::endl;
+        std::cout << "Sobreviventes (" << r.sobreviventes.size() << "):" << std::endl;
+        for (size_t i = 0; i < r.sobreviventes.size(); i++) {
+            std::cout << "  " << opcoes.candidatas[r.sobreviventes[i]].descricao()
+                      << "  (posto médio " << Utils::formatarDouble(r.postoMedio[i], 2) << ")" << std::endl;
+        }
+        if (r.escolhida >= 0 && !r.conclusiva && r.sobreviventes.size() > 1) {
+            std::cout << "Corrida inconclusiva: nenhum teste de Friedman foi significativo; "
+                      << "recomendada a de menor posto médio, sem equivalência estatística" << std::endl;
+        }
+        if (r.escolhida >= 0) {
+            std::cout << "Recomendada: " << opcoes.candidatas[r.escolhida].descricao() << std::endl;
+        }
+    }
+    std::cout << "\nTempo: " << Utils::formatarDouble(crono.getTempoSegundos(), 2) << " segundos" << std::endl;
+    return 0;
+}
+
+/**
+ * Comparação A/B: cmst compare <a.csv> <b.csv> [opcoes]
+ * @return Código de saída do programa (2 se houver regressão)
+ */
+int executarComparacao(int argc, char* argv[]) {
+    OpcoesComparacao opcoes;
+    std::vector<std::string> arquivos;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--nivel") == 0 && i + 1 < argc) {
+            opcoes.nivel = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--tolerancia-tempo") == 0 && i + 1 < argc) {
+            opcoes.toleranciaTempo = std::stod(argv[++i]);
+        } else if (strncmp(argv[i], "--", 2) != 0) {
+            arquivos.push_back(argv[i]);
+        }
+    }
+    if (arquivos.size() != 2) {
+        std::cerr << "Erro: 'compare' requer dois arquivos CSV de resultados" << std::endl;
+        return 1;
+    }
+    
+    std::vector<ExecucaoCSV> a, b;
+    std::string erro;
+    if (!Comparacao::lerCSV(arquivos[0], a, erro) || !Comparacao::lerCSV(arquivos[1], b, erro)) {
+        std::cerr << "Erro: " << erro << std::endl;
+        return 1;
+    }
+    ResultadoComparacao r = Comparacao::comparar(a, b, opcoes);
+    
+    int pares = 0;
+    for (const GrupoComparacao& g : r.grupos) pares += g.numPares;
+    std::cout << "A: " << arquivos[0] << " (" << a.size() << " execuções)" << std::endl;
+    std::cout << "B: " << arquivos[1] << " (" << b.size() << " execuções)" << std::endl;
+    std::cout << "Pares: " << pares << " em " << r.grupos.size() << " grupo(s); sem par: "
+              << r.semParA << " em A, " << r.semParB << " em B" << std::endl;
+    std::cout << "Diferenças B - A; Wilcoxon bilateral, nível " << opcoes.nivel << "\n" << std::endl;
+    
+    std::cout << std::left << std::setw(14) << "instancia" << std::setw(13) << "algoritmo"
+              << std::setw(32) << "parametros" << std::right << std::setw(6) << "pares"
+              << std::setw(11) << "custo_A" << std::setw(11) << "custo_B" << std::setw(10) << "d_custo"
+              << std::setw(8) << "p" << std::setw(11) << "tempo_A" << std::setw(11) << "tempo_B"
+              << std::setw(9) << "d_tempo" << std::setw(8) << "p" << "  situacao" << std::endl;
+    for (const GrupoComparacao& g : r.grupos) {
+        std::string situacao;
+        if (g.regressaoCusto) situacao += " REGRESSÃO(custo)";
+        if (g.regressaoTempo) situacao += " REGRESSÃO(tempo)";
+        if (g.melhoraCusto) situacao += " melhora(custo)";
+        if (g.melhoraTempo) situacao += " melhora(tempo)";
+        std::string deltaTempo = (g.deltaTempo >= 0 ? "+" : "") + Utils::formatarDouble(100 * g.deltaTempo, 1) + "%";
+        std::cout << std::left << std::setw(14) << g.instancia << std::setw(13) << g.algoritmo
+                  << std::setw(32) << g.parametros << std::right << std::setw(6) << g.numPares
+                  << std::setw(11) << Utils::formatarDouble(g.custoA, 2)
+                  << std::setw(11) << Utils::formatarDouble(g.custoB, 2)
+                  << std::setw(10) << Utils::formatarDouble(g.deltaCusto, 2)
+                  << std::setw(8) << Utils::formatarDouble(g.valorPCusto, 4)
+                  << std::setw(11) << Utils::formatarDouble(g.tempoA, 4)
+                  << std::setw(11) << Utils::formatarDouble(g.tempoB, 4)
+                  << std::setw(9) << deltaTempo
+                  << std::setw(8) << Utils::formatarDouble(g.valorPTempo, 4)
+                  << " " << situacao << std::endl;
+    }
+    
+    std::cout << "\nRegressões: " << r.regressoes << " grupo(s)" << std::endl;
+    return r.regressoes > 0 ? 2 : 0;
+}
+
+/**
+ * Varredura de capacidades: o grafo é carregado uma vez e cada Q é resolvido em
+ * sequência. Os índices independentes de Q (vizinhos ordenados) são calculados uma
+ * única vez, e cada Q parte da solução do Q anterior adaptada (subárvores fundidas
+ * quando Q cresce, divididas quando Q diminui). Grava uma linha do CSV por Q.
+ * @return false se o algoritmo for desconhecido ou se os resultados não puderem ser gravados
+ */
+bool executarVarredura(Grafo& grafo, Algoritmos& alg, const ParametrosExecucao& params,
+                       const std::vector<int>& capacidades, const RepositorioSolucoes* repositorio,
+                       const std::string& opcoesGrafo, const std::string& arquivoCSV,
+                       const std::string& arquivoJSONL, bool usarLock, bool verbose) {
+    grafo.prepararIndices();
+    
+    EscritorCSV escritor(arquivoCSV, usarLock);
+    std::unique_ptr<EscritorJSONL> escritorJSONL;
+    if (!arquivoJSONL.empty()) {
+        escritorJSONL.reset(new EscritorJSONL(arquivoJSONL, usarLock));
+    }
+    
+    int capacidadeOriginal = grafo.getCapacidade();
+    std::vector<ResultadoExecucao> curva;
+    std::vector<bool> validas;
+    Solucao anterior(&grafo);
+    bool temAnterior = false;
+    
+    for (int q : capacidades) {
+        grafo.setCapacidade(q);
+        
+        // Semente: solução do Q anterior adaptada ou a do repositório, a que for melhor
+        std::vector<int> paisIniciais;
+        double custoInicial = INFINITO;
+        if (temAnterior) {
+            Solucao adaptada = alg.adaptarCapacidade(anterior);
+            if (adaptada.isValida()) {
+                paisIniciais = adaptada.getVetorPais();
+                custoInicial = adaptada.getCustoTotal();
+            }
+        }
+        
+        std::vector<int> paisConhecidos;
+        double custoConhecido = INFINITO;
+        if (repositorio != nullptr && repositorio->carregar(grafo, paisConhecidos, custoConhecido) &&
+            custoConhecido < custoInicial) {
+            paisIniciais = paisConhecidos;
+            custoInicial = custoConhecido;
+        }
+        alg.setSolucaoInicial(paisIniciais);
+        
+        if (verbose) {
+            std::cout << "\n=== Capacidade Q = " << q << " ===" << std::endl;
+            if (custoInicial < INFINITO) {
+                std::cout << "Solução de partida: " << Utils::formatarDouble(custoInicial, 2) << std::endl;
+            }
+        }
+        
+        ResultadoExecucao resultado;
+        Solucao melhorSolucao(&grafo);
+        std::string erro;
+        if (!CMST::executarAlgoritmo(alg, params, resultado, melhorSolucao, verbose, &erro)) {
+            std::cerr << erro << std::endl;
+            return false;
+        }
+        if (q != capacidadeOriginal) {
+            resultado.solucaoOtima = -1;  // O ótimo conhecido vale apenas para o Q da instância
+        }
+        acrescentarOpcao(resultado.opcoes, opcoesGrafo);
+        acrescentarOpcao(resultado.opcoes, paisIniciais.empty() ? "" : "inicial");
+        
+        if (repositorio != nullptr) {
+            repositorio->salvarSeMelhor(grafo, melhorSolucao);
+        }
+        
+        escritor.escreverResultado(resultado);
+        if (escritorJSONL) {
+            escritorJSONL->escreverResultado(resultado, grafo.paisParaOriginal(melhorSolucao.getVetorPais()));
+        }
+        
+        curva.push_back(resultado);
+        validas.push_back(melhorSolucao.isValida());
+        if (melhorSolucao.isValida()) {
+            anterior = melhorSolucao;
+            temAnterior = true;
+        }
+    }
+    
+    bool gravado = escritor.descarregar();
+    if (escritorJSONL) {
+        gravado = escritorJSONL->descarregar() && gravado;
+    }
+    
+    // Curva custo x capacidade
+    std::cout << "\n=== Curva de custo por capacidade ===" << std::endl;
+    std::cout << "Q,custo,tempo_segundos,valida" << std::endl;
+    for (size_t i = 0; i < curva.size(); i++) {
+        std::cout << curva[i].capacidade << ","
+                  << Utils::formatarDouble(curva[i].melhorSolucao, 2) << ","
+                  << Utils::formatarDouble(curva[i].tempoSegundos, 6) << ","
+                  << (validas[i] ? "Sim" : "Não") << std::endl;
+    }
+    if (!gravado) {
+        return false;
+    }
+    std::cout << "Resultados salvos em: " << arquivoCSV << std::endl;
+    if (escritorJSONL) {
+        std::cout << "Registro JSON lines salvo em: " << arquivoJSONL << std::endl;
+    }
+    
+    return true;
+}
+
 int main(int argc, char* argv[]) {
+    // Modo servidor: cmst serve --socket <caminho> [--threads <num>] [--verbose]
+    if (argc >= 2 && strcmp(argv[1], "serve") == 0) {
+        std::string caminhoSocket;
+        int numThreads = 0;
+        bool detalhado = false;
+        for (int i = 2; i < argc; i++) {
+            if (strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+                caminhoSocket = argv[++i];
+            } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                numThreads = std::stoi(argv[++i]);
+            } else if (strcmp(argv[i], "--verbose") == 0) {
+                detalhado = true;
+            } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
+                imprimirAjuda(argv[0]);
+                return 0;
+            }
+        }
+        if (caminhoSocket.empty()) {
+            std::cerr << "Erro: 'serve' requer --socket <caminho>" << std::endl;
+            return 1;
+        }
+        ServidorCMST servidor(caminhoSocket, numThreads, detalhado);
+        return servidor.executar() ? 0 : 1;
+    }
+    
+    // Conversão de trace: cmst trace2csv <trace> [saida.csv]
+    if (argc >= 3 && strcmp(argv[1], "trace2csv") == 0) {
+        std::ofstream arquivoSaida;
+        if (argc >= 4) {
+            arquivoSaida.open(argv[3]);
+            if (!arquivoSaida) {
+                std::cerr << "Erro: não foi possível criar " << argv[3] << std::endl;
+                return 1;
+            }
+        }
+        std::string erro;
+        long eventos = RegistroTrace::converterCSV(argv[2], argc >= 4 ? arquivoSaida : std::cout, erro);
+        if (!erro.empty()) {
+            std::cerr << erro << std::endl;
+        }
+        return eventos >= 0 ? 0 : 1;
+    }
+    
+    // Comparação A/B: cmst compare <a.csv> <b.csv> [opcoes]
+    if (argc >= 2 && strcmp(argv[1], "compare") == 0) {
+        return executarComparacao(argc, argv);
+    }
+    
+    // Sintonia por corrida: cmst tune <instancia> [<instancia> ...] [opcoes]
+    if (argc >= 2 && strcmp(argv[1], "tune") == 0) {
+        return executarSintonia(argc, argv);
+    }
+    
     // Verificar argumentos mínimos
     if (argc < 3) {
         imprimirAjuda(argv[0]);
@@ -84,14 +531,16 @@ int main(int argc, char* argv[]) {
     std::string arquivoInstancia = argv[1];
     std::string algoritmo = argv[2];
     std::string arquivoCSV = ARQUIVO_CSV;
+    std::string arquivoJSONL;
+    bool usarLock = false;
+    bool warmStart = false;
+    bool usarPoda = false;
+    std::string renumeracao;  // Vazio = numeração do arquivo
+    std::string diretorioWarm = DIRETORIO_WARM;
     
-    // Parâmetros do randomizado
-    double alpha = 0.3;
-    int numIteracoes = 30;
-    
-    // Parâmetros do reativo
-    std::vector<double> alphas = {0.1, 0.3, 0.5};
-    int tamanhoBloco = 30;
+    ParametrosExecucao params;
+    params.algoritmo = algoritmo;
+    std::vector<int> capacidades;  // Varredura de capacidades (vazio = Q da instância)
     
     // Opções
     bool usarSemente = false;
@@ -101,27 +550,76 @@ int main(int argc, char* argv[]) {
     // Parsear argumentos opcionais
     for (int i = 3; i < argc; i++) {
         if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
-            alpha = std::stod(argv[++i]);
+            params.alpha = std::stod(argv[++i]);
         } else if (strcmp(argv[i], "--alphas") == 0 && i + 1 < argc) {
-            alphas = parsearAlphas(argv[++i]);
+            params.alphas = parsearAlphas(argv[++i]);
         } else if (strcmp(argv[i], "--iter") == 0 && i + 1 < argc) {
-            numIteracoes = std::stoi(argv[++i]);
+            params.numIteracoes = std::stoi(argv[++i]);
         } else if (strcmp(argv[i], "--bloco") == 0 && i + 1 < argc) {
-            tamanhoBloco = std::stoi(argv[++i]);
+            params.tamanhoBloco = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--alpha-policy") == 0 && i + 1 < argc) {
+            params.politicaAlpha = argv[++i];
+        } else if (strcmp(argv[i], "--alpha-faixa") == 0 && i + 1 < argc) {
+            std::vector<double> faixa = parsearAlphas(argv[++i]);
+            if (faixa.size() == 2) {
+                params.alphaMin = faixa[0];
+                params.alphaMax = faixa[1];
+            }
+        } else if (strcmp(argv[i], "--bracos") == 0 && i + 1 < argc) {
+            params.numBracos = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--abandono") == 0) {
+            params.abandono = true;
+        } else if (strcmp(argv[i], "--troca-ciclica") == 0) {
+            params.trocaCiclica = true;
+        } else if (strcmp(argv[i], "--recombinar") == 0 && i + 1 < argc) {
+            params.intervaloRecombinacao = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ilhas") == 0 && i + 1 < argc) {
+            params.numIlhas = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--migracao") == 0 && i + 1 < argc) {
+            params.intervaloMigracao = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--remocao") == 0 && i + 1 < argc) {
+            params.fracaoRemocao = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--edicoes") == 0 && i + 1 < argc) {
+            params.arquivoEdicoes = argv[++i];
+        } else if (strcmp(argv[i], "--tempo") == 0 && i + 1 < argc) {
+            params.tempoLimite = std::stod(argv[++i]);
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            params.arquivoCheckpoint = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-intervalo") == 0 && i + 1 < argc) {
+            params.intervaloCheckpoint = std::stoi(argv[++i]);
+        } else if (strcmp(argv[i], "--resume") == 0) {
+            params.retomar = true;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            params.arquivoTrace = argv[++i];
+        } else if (strcmp(argv[i], "--construtor") == 0 && i + 1 < argc) {
+            params.construtor = argv[++i];
+        } else if (strcmp(argv[i], "--capacidades") == 0 && i + 1 < argc) {
+            capacidades = parsearCapacidades(argv[++i]);
         } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
             semente = std::stoul(argv[++i]);
             usarSemente = true;
         } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
             arquivoCSV = argv[++i];
+        } else if (strcmp(argv[i], "--jsonl") == 0 && i + 1 < argc) {
+            arquivoJSONL = argv[++i];
+        } else if (strcmp(argv[i], "--lock") == 0) {
+            usarLock = true;
+        } else if (strcmp(argv[i], "--warm-start") == 0) {
+            warmStart = true;
+        } else if (strcmp(argv[i], "--warm-dir") == 0 && i + 1 < argc) {
+            diretorioWarm = argv[++i];
+            warmStart = true;
+        } else if (strcmp(argv[i], "--renumerar") == 0 && i + 1 < argc) {
+            renumeracao = argv[++i];
+        } else if (strcmp(argv[i], "--poda") == 0) {
+            usarPoda = true;
         } else if (strcmp(argv[i], "--verbose") == 0) {
             verbose = true;
         }
     }
     
-    // Ajustar iterações padrão para reativo
-    if (algoritmo == "reativo" && numIteracoes == 30) {
-        numIteracoes = 300;  // Default para reativo é 300
-    }
+    // Iterações e alpha não informados recebem os padrões do algoritmo
+    params = params.comPadroes();
     
     // Inicializar randomização
     if (usarSemente) {
@@ -137,10 +635,31 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    // Renumeração interna para localidade (a saída mantém os IDs do arquivo)
+    if (renumeracao == "raiz") {
+        grafo.renumerar(grafo.ordemPorRaiz());
+    } else if (renumeracao == "rcm") {
+        grafo.renumerar(grafo.ordemCuthillMcKee(std::min(10, grafo.getNumVertices() - 1)));
+    } else if (!renumeracao.empty()) {
+        std::cerr << "Renumeração desconhecida: " << renumeracao << " (use raiz ou rcm)" << std::endl;
+        return 1;
+    }
+    
+    // Pré-processamento: eliminar arestas que não precisam ser consideradas
+    std::string opcoesGrafo = renumeracao.empty() ? "" : "renumerar=" + renumeracao;
+    if (usarPoda) {
+        acrescentarOpcao(opcoesGrafo, "poda");
+        int eliminadas = grafo.aplicarPoda();
+        int total = grafo.getNumArestasTotal();
+        std::cout << "Poda: " << eliminadas << " de " << total << " arestas eliminadas ("
+                  << Utils::formatarDouble(total > 0 ? 100.0 * eliminadas / total : 0, 1) << "%)" << std::endl;
+    }
+    
     if (verbose) {
         std::cout << "=== Configuração ===" << std::endl;
         std::cout << "Instância: " << arquivoInstancia << std::endl;
         std::cout << "Algoritmo: " << algoritmo << std::endl;
+        std::cout << "Construtor: " << params.construtor << std::endl;
         std::cout << "Semente: " << semente << std::endl;
         grafo.imprimir();
         std::cout << std::endl;
@@ -148,47 +667,102 @@ int main(int argc, char* argv[]) {
     
     // Criar estruturas
     Algoritmos alg(&grafo);
+    if (!alg.setConstrutor(params.construtor)) {
+        std::cerr << "Construtor desconhecido: " << params.construtor << " (use prim ou kruskal)" << std::endl;
+        return 1;
+    }
+    if (!alg.setPoliticaAlpha(params.politicaAlpha)) {
+        std::cerr << "Política de alpha desconhecida: " << params.politicaAlpha
+                  << " (use roleta, ucb1 ou thompson)" << std::endl;
+        return 1;
+    }
     ResultadoExecucao resultado;
     Solucao melhorSolucao(&grafo);
     
+    // Repositório só com warm start (a gravação cria o diretório)
+    std::unique_ptr<RepositorioSolucoes> repositorio;
+    if (warmStart) {
+        repositorio.reset(new RepositorioSolucoes(diretorioWarm));
+    }
+    
+    // Varredura de capacidades: resolve todos os Q com o mesmo grafo carregado
+    if (!capacidades.empty()) {
+        if (algoritmo == "reotimizar") {
+            std::cerr << "Erro: --capacidades não se aplica a 'reotimizar'" << std::endl;
+            return 1;
+        }
+        return executarVarredura(grafo, alg, params, capacidades, repositorio.get(), opcoesGrafo,
+                                 arquivoCSV, arquivoJSONL, usarLock, verbose) ? 0 : 1;
+    }
+    
+    // Warm start: semear com a melhor solução conhecida desta instância e Q
+    double custoConhecido = INFINITO;
+    if (warmStart) {
+        std::vector<int> paisConhecidos;
+        if (repositorio->carregar(grafo, paisConhecidos, custoConhecido)) {
+            alg.setSolucaoInicial(paisConhecidos);
+            params.paisIniciais = paisConhecidos;
+            std::cout << "Warm start: solução conhecida de custo "
+                      << Utils::formatarDouble(custoConhecido, 2) << std::endl;
+        } else {
+            std::cout << "Warm start: nenhuma solução conhecida para esta instância" << std::endl;
+        }
+    }
+    
     // Executar algoritmo
-    if (algoritmo == "guloso") {
-        if (verbose) {
-            std::cout << "Executando algoritmo guloso..." << std::endl;
+    if (algoritmo == "reotimizar") {
+        EdicaoInstancia edicoes;
+        if (params.arquivoEdicoes.empty()) {
+            std::cerr << "Erro: 'reotimizar' requer --edicoes <arquivo>" << std::endl;
+            return 1;
         }
-        melhorSolucao = alg.executarGuloso(resultado, verbose);
-        
-    } else if (algoritmo == "randomizado") {
-        if (verbose) {
-            std::cout << "Executando algoritmo randomizado..." << std::endl;
-            std::cout << "  Alpha: " << alpha << std::endl;
-            std::cout << "  Iterações: " << numIteracoes << std::endl;
+        if (!edicoes.carregar(params.arquivoEdicoes, grafo.getNumVertices())) {
+            return 1;
         }
-        melhorSolucao = alg.executarGulosoRandomizado(alpha, numIteracoes, resultado, verbose);
+        edicoes = edicoes.paraIdsInternos(grafo);
+        
+        // Solução base para a instância original (warm start, se houver, ou gulosa)
+        ResultadoExecucao resultadoBase;
+        Solucao base = alg.executarGuloso(resultadoBase, false);
+        
+        edicoes.aplicar(grafo);
         
-    } else if (algoritmo == "reativo") {
         if (verbose) {
-            std::cout << "Executando algoritmo reativo..." << std::endl;
-            std::cout << "  Alphas: ";
-            for (size_t i = 0; i < alphas.size(); i++) {
-                std::cout << alphas[i];
-                if (i < alphas.size() - 1) std::cout << ", ";
-            }
-            std::cout << std::endl;
-            std::cout << "  Iterações: " << numIteracoes << std::endl;
-            std::cout << "  Tamanho do bloco: " << tamanhoBloco << std::endl;
+            std::cout << "Executando re-otimização incremental..." << std::endl;
+            std::cout << "  Custo da solução base: " << base.getCustoTotal() << std::endl;
+            std::cout << "  Alterações: " << edicoes.custos.size() << " custo(s), "
+                      << edicoes.demandas.size() << " demanda(s), "
+                      << edicoes.novosTerminais.size() << " terminal(is) novo(s)" << std::endl;
         }
-        melhorSolucao = alg.executarGulosoReativo(alphas, numIteracoes, tamanhoBloco, resultado, verbose);
+        melhorSolucao = alg.reotimizar(base, edicoes, params.numIteracoes, resultado, verbose);
         
     } else {
-        std::cerr << "Algoritmo desconhecido: " << algoritmo << std::endl;
-        imprimirAjuda(argv[0]);
-        return 1;
+        std::string erro;
+        if (!CMST::resolver(grafo, params, melhorSolucao, resultado, nullptr, &erro, verbose)) {
+            std::cerr << erro << std::endl;
+            imprimirAjuda(argv[0]);
+            return 1;
+        }
+    }
+    
+    acrescentarOpcao(resultado.opcoes, opcoesGrafo);
+    acrescentarOpcao(resultado.opcoes, params.paisIniciais.empty() ? "" : "inicial");
+    
+    // Gravar de volta no repositório se melhorou a solução conhecida
+    if (warmStart && repositorio->salvarSeMelhor(grafo, melhorSolucao)) {
+        std::cout << "Warm start: nova melhor solução gravada em " << repositorio->getDiretorio() << std::endl;
     }
     
-    // Salvar resultado em CSV
-    EscritorCSV escritor(arquivoCSV);
+    // Salvar resultado em CSV (e JSON lines, se pedido)
+    EscritorCSV escritor(arquivoCSV, usarLock);
     escritor.escreverResultado(resultado);
+    bool gravado = escritor.descarregar();
+    
+    if (!arquivoJSONL.empty()) {
+        EscritorJSONL escritorJSONL(arquivoJSONL, usarLock);
+        escritorJSONL.escreverResultado(resultado, grafo.paisParaOriginal(melhorSolucao.getVetorPais()));
+        gravado = escritorJSONL.descarregar() && gravado;
+    }
     
     // Imprimir resultado
     std::cout << "\n=== Resultado ===" << std::endl;
@@ -205,6 +779,17 @@ int main(int argc, char* argv[]) {
         std::cout << "Melhor alpha: " << Utils::formatarDouble(resultado.melhorAlpha, 2) << std::endl;
     }
     
+    if (resultado.taxaAbandono >= 0) {
+        std::cout << "Construções abandonadas: " << Utils::formatarDouble(100 * resultado.taxaAbandono, 1)
+                  << "%" << std::endl;
+    }
+    
+    if (resultado.tamanhoPool >= 0) {
+        std::cout << "Recombinação: " << resultado.melhoriasRecombinacao << " melhoria(s) em "
+                  << resultado.recombinacoes << " particionamento(s), pool de " << resultado.tamanhoPool
+                  << " subárvores, " << Utils::formatarDouble(resultado.tempoRecombinacao, 3) << " s" << std::endl;
+    }
+    
     if (resultado.solucaoOtima > 0) {
         double desvio = ((resultado.melhorSolucao - resultado.solucaoOtima) / resultado.solucaoOtima) * 100;
         std::cout << "Solução ótima conhecida: " << Utils::formatarDouble(resultado.solucaoOtima, 2) << std::endl;
@@ -215,7 +800,12 @@ int main(int argc, char* argv[]) {
     }
     
     std::cout << "Solução válida: " << (melhorSolucao.isValida() ? "Sim" : "Não") << std::endl;
-    std::cout << "Resultado salvo em: " << arquivoCSV << std::endl;
+    if (gravado) {
+        std::cout << "Resultado salvo em: " << arquivoCSV << std::endl;
+        if (!arquivoJSONL.empty()) {
+            std::cout << "Registro JSON lines salvo em: " << arquivoJSONL << std::endl;
+        }
+    }
     
     // Imprimir solução no formato CS Academy
     std::cout << "\n=== Solução (formato CS Academy) ===" << std::endl;
@@ -226,5 +816,5 @@ int main(int argc, char* argv[]) {
         melhorSolucao.imprimir();
     }
     
-    return 0;
+    return gravado ? 0 : 1;
 }
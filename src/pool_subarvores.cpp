@@ -0,0 +1,243 @@
+#include "../includes/pool_subarvores.h"
+#include "../includes/algoritmos.h"
+#include <algorithm>
+
+namespace {
+    const int MAX_COLUNAS_POOL = 100000;   // Colunas além disso são descartadas
+    const double EPSILON_PARTICAO = 1e-9;
+
+    // Branch-and-bound em profundidade do particionamento de conjuntos
+    struct BuscaParticao {
+        const std::vector<ColunaPool>& colunas;
+        const std::vector<std::vector<int>>& colunasPorVertice;  // Ordenadas por custo por vértice
+        const std::vector<double>& limiteVertice;                // Menor custo por vértice das colunas de v
+        const std::vector<int>& ordem;                           // Terminais por número de colunas
+        long maxNos;
+
+        std::vector<uint64_t> coberto;
+        std::vector<int> escolhidas;
+        std::vector<int> melhorEscolha;
+        double melhorCusto;
+        long nos = 0;
+
+        BuscaParticao(const std::vector<ColunaPool>& c, const std::vector<std::vector<int>>& cpv,
+                      const std::vector<double>& lv, const std::vector<int>& o, int numPalavras,
+                      double limiteSuperior, long maxNos)
+            : colunas(c), colunasPorVertice(cpv), limiteVertice(lv), ordem(o), maxNos(maxNos),
+              coberto(numPalavras, 0), melhorCusto(limiteSuperior) {}
+
+        bool estaCoberto(int v) const {
+            return (coberto[v >> 6] >> (v & 63)) & 1;
+        }
+
+        bool disjunta(const ColunaPool& c) const {
+            for (size_t w = 0; w < coberto.size(); w++) {
+                if (c.conjunto[w] & coberto[w]) return false;
+            }
+            return true;
+        }
+
+        void buscar(double custo, double restante) {
+            if (++nos > maxNos) return;
+
+            // Ramifica no primeiro terminal descoberto (o de menos colunas)
+            int v = -1;
+            for (int t : ordem) {
+                if (!estaCoberto(t)) {
+                    v = t;
+                    break;
+                }
+            }
+            if (v == -1) {
+                if (custo < melhorCusto - EPSILON_PARTICAO) {
+                    melhorCusto = custo;
+                    melhorEscolha = escolhidas;
+                }
+                return;
+            }
+
+            for (int id : colunasPorVertice[v]) {
+                if (nos > maxNos) return;
+                const ColunaPool& c = colunas[id];
+                if (!disjunta(c)) continue;
+
+                double novoRestante = restante;
+                for (int u : c.vertices) novoRestante -= limiteVertice[u];
+                if (custo + c.custo + novoRestante >= melhorCusto - EPSILON_PARTICAO) continue;
+
+                for (size_t w = 0; w < coberto.size(); w++) coberto[w] |= c.conjunto[w];
+                escolhidas.push_back(id);
+                buscar(custo + c.custo, novoRestante);
+                escolhidas.pop_back();
+                for (size_t w = 0; w < coberto.size(); w++) coberto[w] &= ~c.conjunto[w];
+            }
+        }
+    };
+}
+
+PoolSubarvores::PoolSubarvores(const Grafo* g, const Algoritmos* alg)
+    : grafo(g), algoritmos(alg), numPalavras((g->getNumVertices() + 63) / 64),
+      novasDesdeRecombinacao(0), numRecombinacoes(0), numMelhorias(0), tempoSegundos(0) {}
+
+std::string PoolSubarvores::chave(const std::vector<uint64_t>& conjunto) {
+    return std::string(reinterpret_cast<const char*>(conjunto.data()), conjunto.size() * sizeof(uint64_t));
+}
+
+// Separa as subárvores da raiz em O(n) e guarda as novas que respeitam a capacidade
+int PoolSubarvores::adicionar(const Solucao& solucao) {
+    Cronometro crono;
+    crono.iniciar();
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+
+    // topo[v] = filho da raiz acima de v (-1 = desconectado, -2 = não visitado)
+    std::vector<int> topo(n, -2);
+    std::vector<int> caminho;
+    for (int v = 0; v < n; v++) {
+        if (v == raiz || topo[v] != -2) continue;
+        caminho.clear();
+        int u = v;
+        int t = -1;
+        while (true) {
+            if (topo[u] != -2) {
+                t = topo[u];
+                break;
+            }
+            caminho.push_back(u);
+            int p = solucao.getPai(u);
+            if (p == raiz) {
+                t = u;
+                break;
+            }
+            if (p < 0 || p >= n || (int)caminho.size() > n) {
+                break;  // Desconectado (ou ciclo)
+            }
+            u = p;
+        }
+        for (int w : caminho) topo[w] = t;
+    }
+
+    std::vector<int> grupoDe(n, -1);
+    std::vector<std::vector<int>> grupos;
+    for (int v = 0; v < n; v++) {
+        if (v == raiz || topo[v] < 0) continue;
+        int& g = grupoDe[topo[v]];
+        if (g == -1) {
+            g = grupos.size();
+            grupos.emplace_back();
+        }
+        grupos[g].push_back(v);
+    }
+
+    int novas = 0;
+    for (std::vector<int>& vertices : grupos) {
+        if ((int)colunas.size() >= MAX_COLUNAS_POOL) break;
+
+        int demanda = 0;
+        std::vector<uint64_t> conjunto(numPalavras, 0);
+        for (int v : vertices) {
+            demanda += grafo->getDemanda(v);
+            conjunto[v >> 6] |= uint64_t(1) << (v & 63);
+        }
+        if (demanda > grafo->getCapacidade()) continue;
+
+        std::string k = chave(conjunto);
+        if (indice.count(k)) continue;
+
+        double custo = algoritmos->arvoreMinimaSubconjunto(vertices);
+        if (custo >= INFINITO) continue;
+
+        indice[k] = colunas.size();
+        colunas.push_back({std::move(conjunto), std::move(vertices), custo});
+        novas++;
+    }
+    novasDesdeRecombinacao += novas;
+    tempoSegundos += crono.getTempoSegundos();
+    return novas;
+}
+
+// Resolve o particionamento e contabiliza a fase de recombinação
+bool PoolSubarvores::recombinar(double limiteSuperior, Solucao& solucao, long maxNos) {
+    Cronometro crono;
+    crono.iniciar();
+    bool melhorou = resolverParticao(limiteSuperior, solucao, maxNos);
+    numRecombinacoes++;
+    if (melhorou) {
+        numMelhorias++;
+    }
+    novasDesdeRecombinacao = 0;
+    tempoSegundos += crono.getTempoSegundos();
+    return melhorou;
+}
+
+// Particionamento de conjuntos por branch-and-bound
+bool PoolSubarvores::resolverParticao(double limiteSuperior, Solucao& solucao, long maxNos) const {
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
+
+    std::vector<std::vector<int>> colunasPorVertice(n);
+    for (int id = 0; id < (int)colunas.size(); id++) {
+        for (int v : colunas[id].vertices) {
+            colunasPorVertice[v].push_back(id);
+        }
+    }
+
+    // Custo por vértice de cada coluna: ordem de tentativa e limite inferior
+    std::vector<double> limiteVertice(n, 0);
+    std::vector<int> ordem;
+    double restante = 0;
+    for (int v = 0; v < n; v++) {
+        if (v == raiz) continue;
+        std::vector<int>& lista = colunasPorVertice[v];
+        if (lista.empty()) {
+            return false;  // Terminal sem coluna: não há partição
+        }
+        std::sort(lista.begin(), lista.end(), [this](int a, int b) {
+            return colunas[a].custo * colunas[b].vertices.size() < colunas[b].custo * colunas[a].vertices.size();
+        });
+        limiteVertice[v] = colunas[lista[0]].custo / colunas[lista[0]].vertices.size();
+        restante += limiteVertice[v];
+        ordem.push_back(v);
+    }
+    std::stable_sort(ordem.begin(), ordem.end(), [&colunasPorVertice](int a, int b) {
+        return colunasPorVertice[a].size() < colunasPorVertice[b].size();
+    });
+
+    BuscaParticao busca(colunas, colunasPorVertice, limiteVertice, ordem, numPalavras, limiteSuperior, maxNos);
+    busca.buscar(0, restante);
+    if (busca.melhorEscolha.empty()) {
+        return false;
+    }
+
+    // Monta a solução com a MST de cada coluna escolhida
+    Solucao combinada(grafo);
+    std::vector<int> pais;
+    for (int id : busca.melhorEscolha) {
+        const std::vector<int>& vertices = colunas[id].vertices;
+        algoritmos->arvoreMinimaSubconjunto(vertices, &pais);
+        for (size_t i = 0; i < vertices.size(); i++) {
+            combinada.setPai(vertices[i], pais[i]);
+        }
+    }
+    combinada.calcularCusto();
+    if (!combinada.verificarViabilidade() || combinada.getCustoTotal() >= limiteSuperior - EPSILON_PARTICAO) {
+        return false;
+    }
+    solucao = combinada;
+    return true;
+}
+
+int PoolSubarvores::getNovasDesdeRecombinacao() const {
+    return novasDesdeRecombinacao;
+}
+
+int PoolSubarvores::tamanho() const {
+    return colunas.size();
+}
+
+void PoolSubarvores::preencherResultado(ResultadoExecucao& resultado) const {
+    resultado.tamanhoPool = colunas.size();
+    resultado.recombinacoes = numRecombinacoes;
+    resultado.melhoriasRecombinacao = numMelhorias;
+    resultado.tempoRecombinacao = tempoSegundos;
+}
@@ -0,0 +1,100 @@
+#include "../includes/repositorio.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+
+// Construtor
+RepositorioSolucoes::RepositorioSolucoes(const std::string& dir) : diretorio(dir) {}
+
+std::string RepositorioSolucoes::getDiretorio() const {
+    return diretorio;
+}
+
+std::string RepositorioSolucoes::caminhoEntrada(const Grafo& grafo) const {
+    char nome[64];
+    snprintf(nome, sizeof(nome), "%016llx_q%d.sol",
+             (unsigned long long)grafo.hashConteudo(), grafo.getCapacidade());
+    return diretorio + "/" + nome;
+}
+
+bool RepositorioSolucoes::lerEntrada(const std::string& caminho, std::vector<int>& pais, double& custo) const {
+    std::ifstream arquivo(caminho);
+    if (!arquivo.is_open()) {
+        return false;
+    }
+    
+    int n = 0;
+    if (!(arquivo >> custo >> n) || n <= 0) {
+        return false;
+    }
+    
+    pais.assign(n, -1);
+    for (int i = 0; i < n; i++) {
+        if (!(arquivo >> pais[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Carrega a melhor solução conhecida
+bool RepositorioSolucoes::carregar(const Grafo& grafo, std::vector<int>& pais, double& custo) const {
+    if (!lerEntrada(caminhoEntrada(grafo), pais, custo) || (int)pais.size() != grafo.getNumVertices()) {
+        return false;
+    }
+    pais = grafo.paisParaInterno(pais);  // O repositório guarda os IDs do arquivo
+    return true;
+}
+
+// Grava a solução se for melhor que a armazenada
+bool RepositorioSolucoes::salvarSeMelhor(const Grafo& grafo, const Solucao& solucao) const {
+    if (!solucao.isValida() || !solucao.estaCompleta()) {
+        return false;
+    }
+    
+    mkdir(diretorio.c_str(), 0755);  // Criado na primeira gravação; falha silenciosa se já existir
+    
+    // Lock do repositório: a comparação e a troca precisam ser uma operação única
+    std::string caminhoLock = diretorio + "/.lock";
+    int fdLock = open(caminhoLock.c_str(), O_WRONLY | O_CREAT, 0644);
+    if (fdLock >= 0) {
+        flock(fdLock, LOCK_EX);
+    }
+    
+    std::string caminho = caminhoEntrada(grafo);
+    std::vector<int> paisAtuais;
+    double custoAtual = INFINITO;
+    bool atualizou = false;
+    
+    if (!lerEntrada(caminho, paisAtuais, custoAtual) || solucao.getCustoTotal() < custoAtual) {
+        std::string temporario = caminho + ".tmp." + std::to_string(getpid());
+        std::ofstream arquivo(temporario);
+        
+        if (arquivo.is_open()) {
+            std::vector<int> pais = grafo.paisParaOriginal(solucao.getVetorPais());
+            arquivo.precision(17);
+            arquivo << solucao.getCustoTotal() << "\n" << pais.size() << "\n";
+            for (size_t i = 0; i < pais.size(); i++) {
+                arquivo << pais[i] << (i + 1 < pais.size() ? " " : "\n");
+            }
+            arquivo.close();
+            
+            if (!arquivo.fail() && rename(temporario.c_str(), caminho.c_str()) == 0) {
+                atualizou = true;
+            } else {
+                std::cerr << "Erro ao gravar solução em " << caminho << ": " << strerror(errno) << std::endl;
+                unlink(temporario.c_str());
+            }
+        }
+    }
+    
+    if (fdLock >= 0) {
+        flock(fdLock, LOCK_UN);
+        close(fdLock);
+    }
+    
+    return atualizou;
+}
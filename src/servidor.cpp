@@ -0,0 +1,501 @@
+#include "../includes/servidor.h"
+#include "../includes/cmst.h"
+#include "../includes/utils.h"
+#include <iostream>
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <omp.h>
+
+// Tamanho máximo de uma linha do protocolo (matrizes embutidas incluídas)
+static const size_t TAMANHO_MAXIMO_LINHA = 64u << 20;
+
+// Intervalo de verificação do pedido de encerramento (ms)
+static const int INTERVALO_POLL = 200;
+
+// Sinal de encerramento (SIGINT/SIGTERM)
+static volatile sig_atomic_t sinalEncerrar = 0;
+
+static void tratarSinal(int) {
+    sinalEncerrar = 1;
+}
+
+// Número JSON (infinito/NaN viram null)
+static std::string numeroJSON(double valor, int precisao) {
+    if (!std::isfinite(valor)) {
+        return "null";
+    }
+    return Utils::formatarDouble(valor, precisao);
+}
+
+// ==================== PoolThreads ====================
+
+PoolThreads::PoolThreads(int numThreads) : encerrando(false) {
+    for (int i = 0; i < std::max(1, numThreads); i++) {
+        threads.emplace_back(&PoolThreads::laco, this);
+    }
+}
+
+PoolThreads::~PoolThreads() {
+    {
+        std::lock_guard<std::mutex> trava(mutex);
+        encerrando = true;
+    }
+    condicao.notify_all();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+void PoolThreads::enviar(std::function<void()> tarefa) {
+    {
+        std::lock_guard<std::mutex> trava(mutex);
+        fila.push_back(std::move(tarefa));
+    }
+    condicao.notify_one();
+}
+
+void PoolThreads::laco() {
+    while (true) {
+        std::function<void()> tarefa;
+        {
+            std::unique_lock<std::mutex> trava(mutex);
+            condicao.wait(trava, [this] { return encerrando || !fila.empty(); });
+            if (fila.empty()) {
+                return;  // Encerrando e sem tarefas pendentes
+            }
+            tarefa = std::move(fila.front());
+            fila.pop_front();
+        }
+        tarefa();
+    }
+}
+
+// ==================== ConexaoCliente ====================
+
+ConexaoCliente::ConexaoCliente(int descritor) : fd(descritor) {}
+
+ConexaoCliente::~ConexaoCliente() {
+    close(fd);
+}
+
+void ConexaoCliente::enviarLinha(const std::string& linha) {
+    std::lock_guard<std::mutex> trava(mutexEscrita);
+    std::string dados = linha + "\n";
+    size_t enviado = 0;
+    while (enviado < dados.size()) {
+        ssize_t r = send(fd, dados.data() + enviado, dados.size() - enviado, MSG_NOSIGNAL);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            return;  // Cliente desconectado
+        }
+        enviado += r;
+    }
+}
+
+// ==================== ServidorCMST ====================
+
+ServidorCMST::ServidorCMST(const std::string& caminho, int threads, bool detalhado)
+    : caminhoSocket(caminho), numThreads(threads), verbose(detalhado), encerrar(false) {
+    if (numThreads <= 0) {
+        numThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+// Retorna a instância residente, carregando do arquivo na primeira vez
+std::shared_ptr<const Grafo> ServidorCMST::obterInstancia(const std::string& id, std::string& erro) {
+    {
+        std::lock_guard<std::mutex> trava(mutexInstancias);
+        auto it = instancias.find(id);
+        if (it != instancias.end()) {
+            return it->second;
+        }
+    }
+
+    // Carregar fora do lock: outras instâncias continuam acessíveis
+    std::shared_ptr<Grafo> grafo = std::make_shared<Grafo>();
+    if (!grafo->carregarInstancia(id)) {
+        erro = "Instância desconhecida: " + id;
+        return nullptr;
+    }
+    grafo->prepararIndices();
+
+    std::lock_guard<std::mutex> trava(mutexInstancias);
+    auto inserido = instancias.emplace(id, grafo);  // Outro pedido pode ter carregado antes
+    return inserido.first->second;
+}
+
+// Monta uma instância a partir da matriz embutida no pedido
+std::shared_ptr<Grafo> ServidorCMST::montarInstancia(const ValorJSON& pedido, std::string& erro) const {
+    const ValorJSON* matriz = pedido.membro("matriz");
+    if (matriz == nullptr || matriz->tipo != ValorJSON::LISTA || matriz->lista.empty()) {
+        erro = "'matriz' deve ser uma lista não vazia";
+        return nullptr;
+    }
+
+    // Lista de linhas ou lista plana com n×n valores
+    std::vector<double> custos;
+    int n = 0;
+    if (matriz->lista[0].tipo == ValorJSON::LISTA) {
+        n = matriz->lista.size();
+        custos.reserve((size_t)n * n);
+        for (const ValorJSON& linha : matriz->lista) {
+            if (linha.tipo != ValorJSON::LISTA || (int)linha.lista.size() != n) {
+                erro = "'matriz' deve ter n linhas com n valores";
+                return nullptr;
+            }
+            for (const ValorJSON& v : linha.lista) {
+                custos.push_back(v.tipo == ValorJSON::NUMERO ? v.numero : INFINITO);
+            }
+        }
+    } else {
+        n = (int)std::lround(std::sqrt((double)matriz->lista.size()));
+        if ((size_t)n * n != matriz->lista.size()) {
+            erro = "'matriz' plana deve ter n×n valores";
+            return nullptr;
+        }
+        for (const ValorJSON& v : matriz->lista) {
+            custos.push_back(v.tipo == ValorJSON::NUMERO ? v.numero : INFINITO);
+        }
+    }
+
+    int capacidade = (int)pedido.numeroOu("capacidade", 0);
+    if (capacidade <= 0) {
+        erro = "'capacidade' obrigatória com 'matriz'";
+        return nullptr;
+    }
+
+    std::vector<int> demandas;
+    const ValorJSON* listaDemandas = pedido.membro("demandas");
+    if (listaDemandas != nullptr) {
+        if (listaDemandas->tipo != ValorJSON::LISTA || (int)listaDemandas->lista.size() != n) {
+            erro = "'demandas' deve ter n valores";
+            return nullptr;
+        }
+        for (const ValorJSON& v : listaDemandas->lista) {
+            demandas.push_back((int)v.numero);
+        }
+    }
+
+    std::shared_ptr<Grafo> grafo = std::make_shared<Grafo>();
+    if (!grafo->carregarMatriz(n, capacidade, custos.data(), demandas.empty() ? nullptr : demandas.data(),
+                               (int)pedido.numeroOu("raiz", 0), pedido.textoOu("nome", "memoria"))) {
+        erro = "Instância inválida";
+        return nullptr;
+    }
+    return grafo;
+}
+
+// Operação resolver
+std::string ServidorCMST::resolver(const ValorJSON& pedido, bool& ok) {
+    ok = false;
+    std::string erro;
+
+    // Instância: embutida no pedido ou residente
+    std::shared_ptr<const Grafo> grafo;
+    if (pedido.membro("matriz") != nullptr) {
+        std::shared_ptr<Grafo> embutida = montarInstancia(pedido, erro);
+        if (embutida) {
+            embutida->prepararIndices();
+            grafo = embutida;
+        }
+    } else {
+        std::string id = pedido.textoOu("instancia", "");
+        if (id.empty()) {
+            erro = "Informe 'instancia' ou 'matriz'";
+        } else {
+            grafo = obterInstancia(id, erro);
+        }
+
+        // Outra capacidade: cópia da instância residente (os índices independem de Q)
+        int capacidade = (int)pedido.numeroOu("capacidade", 0);
+        if (grafo && capacidade > 0 && capacidade != grafo->getCapacidade()) {
+            std::shared_ptr<Grafo> copia = std::make_shared<Grafo>(*grafo);
+            copia->setCapacidade(capacidade);
+            copia->prepararIndices();
+            grafo = copia;
+        }
+    }
+    if (!grafo) {
+        return ",\"erro\":\"" + Utils::escaparJSON(erro) + "\"";
+    }
+
+    ParametrosExecucao p;
+    p.algoritmo = pedido.textoOu("algoritmo", "guloso");
+    p.construtor = pedido.textoOu("construtor", "prim");
+    p.alpha = pedido.numeroOu("alpha", -1);
+    p.numIteracoes = (int)pedido.numeroOu("iter", -1);
+    p.tamanhoBloco = (int)pedido.numeroOu("bloco", p.tamanhoBloco);
+    p.politicaAlpha = pedido.textoOu("politica", p.politicaAlpha);
+    p.alphaMin = pedido.numeroOu("alpha_min", p.alphaMin);
+    p.alphaMax = pedido.numeroOu("alpha_max", p.alphaMax);
+    p.numBracos = (int)pedido.numeroOu("bracos", p.numBracos);
+    p.numIlhas = (int)pedido.numeroOu("ilhas", p.numIlhas);
+    p.intervaloMigracao = (int)pedido.numeroOu("migracao", p.intervaloMigracao);
+    p.fracaoRemocao = pedido.numeroOu("remocao", p.fracaoRemocao);
+    p.abandono = pedido.booleanoOu("abandono", p.abandono);
+    p.trocaCiclica = pedido.booleanoOu("troca_ciclica", p.trocaCiclica);
+    p.intervaloRecombinacao = (int)pedido.numeroOu("recombinar", p.intervaloRecombinacao);
+    const ValorJSON* alphas = pedido.membro("alphas");
+    if (alphas != nullptr && alphas->tipo == ValorJSON::LISTA) {
+        p.alphas.clear();
+        for (const ValorJSON& a : alphas->lista) {
+            if (a.tipo == ValorJSON::NUMERO && a.numero >= 0 && a.numero <= 1) {
+                p.alphas.push_back(a.numero);
+            }
+        }
+    }
+
+    // Semente sempre explícita, para que a resposta permita reproduzir o pedido
+    p.usarSemente = true;
+    p.semente = pedido.membro("seed") != nullptr ? (unsigned int)pedido.numeroOu("seed", 0)
+                                                 : Randomizador::inicializar();
+
+    // Orçamento de tempo: limite da busca tabu e cancelamento dos demais algoritmos
+    double tempo = pedido.numeroOu("tempo", -1);
+    if (tempo > 0) {
+        p.tempoLimite = tempo;
+    }
+    Cronometro crono;
+    crono.iniciar();
+    ControleExecucao controle;
+    if (tempo > 0) {
+        controle.setCallbackProgresso([&](const ProgressoExecucao&) {
+            if (crono.getTempoSegundos() >= tempo) {
+                controle.cancelar();
+            }
+        });
+    }
+
+    Solucao solucao(grafo.get());
+    ResultadoExecucao resultado;
+    if (!CMST::resolver(*grafo, p, solucao, resultado, &controle, &erro)) {
+        return ",\"erro\":\"" + Utils::escaparJSON(erro) + "\"";
+    }
+
+    ok = true;
+    std::string r;
+    r += ",\"instancia\":\"" + Utils::escaparJSON(resultado.instancia) + "\"";
+    r += ",\"algoritmo\":\"" + resultado.algoritmo + "\"";
+    r += ",\"construtor\":\"" + resultado.construtor + "\"";
+    r += ",\"capacidade\":" + std::to_string(resultado.capacidade);
+    r += ",\"custo\":" + numeroJSON(resultado.melhorSolucao, 2);
+    r += ",\"valida\":" + std::string(solucao.isValida() ? "true" : "false");
+    r += ",\"tempo_segundos\":" + numeroJSON(resultado.tempoSegundos, 6);
+    r += ",\"iteracoes\":" + std::to_string(resultado.iteracoes);
+    if (resultado.taxaAbandono >= 0) {
+        r += ",\"taxa_abandono\":" + numeroJSON(resultado.taxaAbandono, 4);
+    }
+    if (resultado.tamanhoPool >= 0) {
+        r += ",\"tamanho_pool\":" + std::to_string(resultado.tamanhoPool);
+        r += ",\"recombinacoes\":" + std::to_string(resultado.recombinacoes);
+        r += ",\"melhorias_recombinacao\":" + std::to_string(resultado.melhoriasRecombinacao);
+        r += ",\"tempo_recombinacao\":" + numeroJSON(resultado.tempoRecombinacao, 6);
+    }
+    r += ",\"semente\":" + std::to_string(resultado.semente);
+    r += ",\"interrompida\":" + std::string(controle.isCancelado() ? "true" : "false");
+    r += ",\"pais\":[";
+    std::vector<int> pais = grafo->paisParaOriginal(solucao.getVetorPais());
+    for (size_t i = 0; i < pais.size(); i++) {
+        if (i > 0) r += ",";
+        r += std::to_string(pais[i]);
+    }
+    r += "]";
+    return r;
+}
+
+// Processa uma linha do protocolo
+std::string ServidorCMST::processar(const std::string& linha) {
+    Cronometro crono;
+    crono.iniciar();
+
+    ValorJSON pedido;
+    std::string erro;
+    std::string id = "null";
+    std::string op;
+    std::string campos;
+    bool ok = false;
+
+    if (!pedido.parsear(linha, erro)) {
+        campos = ",\"erro\":\"JSON inválido: " + Utils::escaparJSON(erro) + "\"";
+    } else if (pedido.tipo != ValorJSON::OBJETO) {
+        campos = ",\"erro\":\"O pedido deve ser um objeto JSON\"";
+    } else {
+        const ValorJSON* valorId = pedido.membro("id");
+        if (valorId != nullptr && valorId->tipo == ValorJSON::TEXTO) {
+            id = "\"" + Utils::escaparJSON(valorId->texto) + "\"";
+        } else if (valorId != nullptr && valorId->tipo == ValorJSON::NUMERO) {
+            id = numeroJSON(valorId->numero, valorId->numero == std::floor(valorId->numero) ? 0 : 6);
+        }
+
+        op = pedido.textoOu("op", "resolver");
+        if (op == "resolver") {
+            campos = resolver(pedido, ok);
+
+        } else if (op == "carregar") {
+            std::shared_ptr<const Grafo> grafo;
+            std::string nome;
+            if (pedido.membro("matriz") != nullptr) {
+                nome = pedido.textoOu("nome", "");
+                std::shared_ptr<Grafo> embutida;
+                if (nome.empty()) {
+                    erro = "'nome' obrigatório para carregar uma matriz";
+                } else if ((embutida = montarInstancia(pedido, erro))) {
+                    embutida->prepararIndices();
+                    grafo = embutida;
+                    std::lock_guard<std::mutex> trava(mutexInstancias);
+                    instancias[nome] = grafo;
+                }
+            } else {
+                nome = pedido.textoOu("arquivo", "");
+                grafo = nome.empty() ? nullptr : obterInstancia(nome, erro);
+                if (nome.empty()) {
+                    erro = "Informe 'arquivo' ou 'matriz'";
+                }
+            }
+            if (grafo) {
+                ok = true;
+                campos = ",\"instancia\":\"" + Utils::escaparJSON(nome) + "\"" +
+                         ",\"n\":" + std::to_string(grafo->getNumVertices()) +
+                         ",\"capacidade\":" + std::to_string(grafo->getCapacidade());
+            } else {
+                campos = ",\"erro\":\"" + Utils::escaparJSON(erro) + "\"";
+            }
+
+        } else if (op == "descartar") {
+            std::lock_guard<std::mutex> trava(mutexInstancias);
+            ok = instancias.erase(pedido.textoOu("instancia", "")) > 0;
+            if (!ok) {
+                campos = ",\"erro\":\"Instância não está carregada\"";
+            }
+
+        } else if (op == "ping") {
+            ok = true;
+
+        } else if (op == "encerrar") {
+            ok = true;
+            encerrar = true;
+
+        } else {
+            campos = ",\"erro\":\"Operação desconhecida: " + Utils::escaparJSON(op) + "\"";
+        }
+    }
+
+    if (verbose) {
+        std::cerr << "[serve] op=" << (op.empty() ? "?" : op) << " id=" << id
+                  << " ok=" << ok << " tempo=" << Utils::formatarDouble(crono.getTempoSegundos(), 6)
+                  << "s" << std::endl;
+    }
+
+    return "{\"id\":" + id + ",\"ok\":" + (ok ? "true" : "false") + campos + "}";
+}
+
+// Atende conexões até receber "encerrar"
+bool ServidorCMST::executar() {
+    sockaddr_un endereco;
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (caminhoSocket.empty() || caminhoSocket.size() >= sizeof(endereco.sun_path)) {
+        std::cerr << "Erro: caminho de socket inválido: " << caminhoSocket << std::endl;
+        return false;
+    }
+    std::strncpy(endereco.sun_path, caminhoSocket.c_str(), sizeof(endereco.sun_path) - 1);
+
+    int fdEscuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fdEscuta < 0) {
+        std::cerr << "Erro ao criar socket: " << strerror(errno) << std::endl;
+        return false;
+    }
+    unlink(caminhoSocket.c_str());  // Socket de uma execução anterior
+    if (bind(fdEscuta, (sockaddr*)&endereco, sizeof(endereco)) != 0 || listen(fdEscuta, 64) != 0) {
+        std::cerr << "Erro ao abrir " << caminhoSocket << ": " << strerror(errno) << std::endl;
+        close(fdEscuta);
+        return false;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, tratarSinal);
+    signal(SIGTERM, tratarSinal);
+
+    std::cout << "Servidor CMST em " << caminhoSocket << " (" << numThreads << " threads)" << std::endl;
+
+    // O pool é declarado antes das conexões: no encerramento, as tarefas pendentes
+    // terminam (e respondem) antes de o pool ser destruído
+    PoolThreads pool(numThreads);
+    
+    // Os núcleos são divididos entre as threads do pool: cada pedido usa no
+    // máximo a sua fração nas regiões OpenMP (evita sobrecarga de threads)
+    int threadsOMP = std::max(1, omp_get_num_procs() / numThreads);
+    std::map<int, std::shared_ptr<ConexaoCliente>> conexoes;
+    std::vector<pollfd> descritores;
+    std::vector<char> buffer(1 << 16);
+
+    while (!encerrar && !sinalEncerrar) {
+        descritores.clear();
+        descritores.push_back({fdEscuta, POLLIN, 0});
+        for (const auto& par : conexoes) {
+            descritores.push_back({par.first, POLLIN, 0});
+        }
+
+        int prontos = poll(descritores.data(), descritores.size(), INTERVALO_POLL);
+        if (prontos < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Erro em poll: " << strerror(errno) << std::endl;
+            break;
+        }
+        if (prontos == 0) {
+            continue;
+        }
+
+        // Novos clientes
+        if (descritores[0].revents & POLLIN) {
+            int fdCliente = accept(fdEscuta, nullptr, nullptr);
+            if (fdCliente >= 0) {
+                conexoes[fdCliente] = std::make_shared<ConexaoCliente>(fdCliente);
+            }
+        }
+
+        // Pedidos: cada linha completa vira uma tarefa do pool
+        for (size_t i = 1; i < descritores.size(); i++) {
+            if (descritores[i].revents == 0) continue;
+            auto it = conexoes.find(descritores[i].fd);
+            std::shared_ptr<ConexaoCliente> conexao = it->second;
+
+            ssize_t lidos = recv(conexao->fd, buffer.data(), buffer.size(), 0);
+            if (lidos <= 0) {
+                if (lidos < 0 && errno == EINTR) continue;
+                conexoes.erase(it);  // Cliente desconectou (tarefas pendentes mantêm o descritor)
+                continue;
+            }
+
+            conexao->pendente.append(buffer.data(), lidos);
+            size_t inicio = 0;
+            size_t fim;
+            while ((fim = conexao->pendente.find('\n', inicio)) != std::string::npos) {
+                std::string linha = conexao->pendente.substr(inicio, fim - inicio);
+                inicio = fim + 1;
+                if (linha.find_first_not_of(" \t\r") == std::string::npos) continue;
+                pool.enviar([this, conexao, linha, threadsOMP]() {
+                    omp_set_num_threads(threadsOMP);
+                    conexao->enviarLinha(processar(linha));
+                });
+            }
+            conexao->pendente.erase(0, inicio);
+
+            if (conexao->pendente.size() > TAMANHO_MAXIMO_LINHA) {
+                conexao->enviarLinha("{\"id\":null,\"ok\":false,\"erro\":\"Pedido excede o tamanho máximo\"}");
+                conexoes.erase(it);
+            }
+        }
+    }
+
+    close(fdEscuta);
+    unlink(caminhoSocket.c_str());
+    std::cout << "Servidor CMST encerrando (pedidos em andamento serão concluídos)" << std::endl;
+    return true;
+}
@@ -0,0 +1,181 @@
+#include "../includes/sintonia.h"
+#include "../includes/estatistica.h"
+#include "../includes/cmst.h"
+#include <iostream>
+#include <sstream>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <cctype>
+#include <omp.h>
+
+std::string ConfiguracaoCandidata::descricao() const {
+    std::ostringstream s;
+    s << "--alphas ";
+    for (size_t i = 0; i < alphas.size(); i++) {
+        if (i > 0) s << ",";
+        s << alphas[i];
+    }
+    s << " --bloco " << tamanhoBloco << " --iter " << numIteracoes;
+    return s.str();
+}
+
+// Produto cartesiano das listas
+std::vector<ConfiguracaoCandidata> Sintonia::montarGrade(const std::vector<std::vector<double>>& conjuntosAlphas,
+                                                         const std::vector<int>& blocos,
+                                                         const std::vector<int>& iteracoes) {
+    std::vector<ConfiguracaoCandidata> grade;
+    for (const std::vector<double>& alphas : conjuntosAlphas) {
+        for (int bloco : blocos) {
+            for (int iter : iteracoes) {
+                grade.push_back({alphas, bloco, iter});
+            }
+        }
+    }
+    return grade;
+}
+
+namespace {
+    // Classe da instância: prefixo alfabético do nome (minúsculo), número de terminais e Q
+    std::string classeInstancia(const Grafo& grafo) {
+        std::string nome = grafo.getNomeInstancia();
+        std::string prefixo;
+        for (char c : nome) {
+            if (!std::isalpha((unsigned char)c)) break;
+            prefixo += (char)std::tolower((unsigned char)c);
+        }
+        return prefixo + std::to_string(grafo.getNumVertices() - 1) + "-Q" + std::to_string(grafo.getCapacidade());
+    }
+
+    // Corrida de uma classe: blocos = instâncias × sementes, alternando as instâncias
+    ResultadoSintonia correr(const std::string& classe, const std::vector<std::shared_ptr<Grafo>>& grafos,
+                             const OpcoesSintonia& opcoes) {
+        int numCandidatas = opcoes.candidatas.size();
+        int numBlocos = grafos.size() * opcoes.numSementes;
+
+        ResultadoSintonia r;
+        r.classe = classe;
+        r.numInstancias = grafos.size();
+        r.blocosTotais = numBlocos;
+        r.blocosAvaliados = 0;
+        r.execucoes = 0;
+        r.execucoesGrade = (long)numCandidatas * numBlocos;
+        r.conclusiva = false;
+
+        std::vector<int> vivas(numCandidatas);
+        for (int c = 0; c < numCandidatas; c++) vivas[c] = c;
+
+        // custos[b][c] = custo da candidata c no bloco b (só as colunas vivas são usadas)
+        std::vector<std::vector<double>> custos;
+        int numThreads = opcoes.numThreads > 0 ? opcoes.numThreads : omp_get_max_threads();
+
+        for (int b = 0; b < numBlocos && vivas.size() > 1; b++) {
+            if (opcoes.orcamento > 0 && r.execucoes + (long)vivas.size() > opcoes.orcamento) {
+                break;
+            }
+            const Grafo& grafo = *grafos[b % grafos.size()];
+            unsigned int semente = opcoes.sementeBase + b / grafos.size();
+
+            std::vector<double> linha(numCandidatas, INFINITO);
+            #pragma omp parallel for schedule(dynamic) num_threads(numThreads)
+            for (int i = 0; i < (int)vivas.size(); i++) {
+                const ConfiguracaoCandidata& cand = opcoes.candidatas[vivas[i]];
+                ParametrosExecucao p;
+                p.algoritmo = "reativo";
+                p.alphas = cand.alphas;
+                p.tamanhoBloco = cand.tamanhoBloco;
+                p.numIteracoes = cand.numIteracoes;
+                p.usarSemente = true;
+                p.semente = semente;
+                Solucao solucao(&grafo);
+                ResultadoExecucao resultado;
+                CMST::resolver(grafo, p, solucao, resultado);
+                linha[vivas[i]] = solucao.isValida() ? resultado.melhorSolucao : INFINITO;
+            }
+            custos.push_back(linha);
+            r.execucoes += vivas.size();
+            r.blocosAvaliados = b + 1;
+
+            if ((int)custos.size() < opcoes.blocosMinimos) {
+                continue;
+            }
+
+            // Friedman sobre as candidatas vivas em todos os blocos já avaliados
+            std::vector<std::vector<double>> matriz;
+            for (const std::vector<double>& l : custos) {
+                std::vector<double> m;
+                for (int c : vivas) m.push_back(l[c]);
+                matriz.push_back(m);
+            }
+            Estatistica::ResultadoFriedman f = Estatistica::friedman(matriz, opcoes.nivel);
+            if (f.valorP >= opcoes.nivel) {
+                continue;
+            }
+            r.conclusiva = true;
+            double melhorSoma = *std::min_element(f.somaPostos.begin(), f.somaPostos.end());
+            std::vector<int> restantes;
+            for (size_t i = 0; i < vivas.size(); i++) {
+                if (f.somaPostos[i] - melhorSoma <= f.diferencaCritica) {
+                    restantes.push_back(vivas[i]);
+                }
+            }
+            if (opcoes.verbose && restantes.size() < vivas.size()) {
+                std::cout << "[" << classe << "] bloco " << b + 1 << ": p = " << f.valorP << ", "
+                          << vivas.size() - restantes.size() << " eliminadas, " << restantes.size()
+                          << " restantes" << std::endl;
+            }
+            vivas = restantes;
+        }
+
+        // Posto médio das sobreviventes nos blocos avaliados
+        r.sobreviventes = vivas;
+        r.postoMedio.assign(vivas.size(), 0);
+        for (const std::vector<double>& l : custos) {
+            std::vector<double> m;
+            for (int c : vivas) m.push_back(l[c]);
+            std::vector<double> p = Estatistica::postos(m);
+            for (size_t i = 0; i < vivas.size(); i++) {
+                r.postoMedio[i] += p[i] / custos.size();
+            }
+        }
+
+        // Recomendação: com algum teste significativo, a sobrevivente mais barata (menos
+        // iterações), depois a de menor posto; sem teste significativo as sobreviventes
+        // não foram mostradas equivalentes, e vale o menor posto, depois a mais barata
+        int escolhida = 0;
+        for (size_t i = 1; i < vivas.size(); i++) {
+            const ConfiguracaoCandidata& a = opcoes.candidatas[vivas[i]];
+            const ConfiguracaoCandidata& e = opcoes.candidatas[vivas[escolhida]];
+            bool maisBarata = a.numIteracoes < e.numIteracoes;
+            bool mesmoCusto = a.numIteracoes == e.numIteracoes;
+            bool melhorPosto = r.postoMedio[i] < r.postoMedio[escolhida];
+            bool mesmoPosto = r.postoMedio[i] == r.postoMedio[escolhida];
+            if (r.conclusiva ? (maisBarata || (mesmoCusto && melhorPosto))
+                             : (melhorPosto || (mesmoPosto && maisBarata))) {
+                escolhida = i;
+            }
+        }
+        r.escolhida = vivas.empty() ? -1 : vivas[escolhida];
+        return r;
+    }
+}
+
+// Uma corrida por classe de instâncias
+std::vector<ResultadoSintonia> Sintonia::executar(const OpcoesSintonia& opcoes, std::string& erro) {
+    std::map<std::string, std::vector<std::shared_ptr<Grafo>>> classes;
+    for (const std::string& arquivo : opcoes.instancias) {
+        std::shared_ptr<Grafo> grafo = std::make_shared<Grafo>();
+        if (!grafo->carregarInstancia(arquivo)) {
+            erro = "Erro ao carregar instância: " + arquivo;
+            return {};
+        }
+        grafo->prepararIndices();  // Antes de compartilhar entre as threads
+        classes[classeInstancia(*grafo)].push_back(grafo);
+    }
+
+    std::vector<ResultadoSintonia> resultados;
+    for (const auto& par : classes) {
+        resultados.push_back(correr(par.first, par.second, opcoes));
+    }
+    return resultados;
+}
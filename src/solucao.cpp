@@ -1,7 +1,5 @@
 #include "../includes/solucao.h"
 #include <algorithm>
-#include <set>
-#include <queue>
 #include <sstream>
 
 // Construtor
@@ -19,7 +17,7 @@ Solucao::Solucao(const Grafo* g) : grafo(g), custoTotal(0), valida(false) {
 // Construtor de cópia
 Solucao::Solucao(const Solucao& outra) 
     : grafo(outra.grafo), pai(outra.pai), subarvore(outra.subarvore),
-      custoTotal(outra.custoTotal), valida(outra.valida) {}
+      demandaSubarvore(outra.demandaSubarvore), custoTotal(outra.custoTotal), valida(outra.valida) {}
 
 // Operador de atribuição
 Solucao& Solucao::operator=(const Solucao& outra) {
@@ -27,6 +25,7 @@ Solucao& Solucao::operator=(const Solucao& outra) {
         grafo = outra.grafo;
         pai = outra.pai;
         subarvore = outra.subarvore;
+        demandaSubarvore = outra.demandaSubarvore;
         custoTotal = outra.custoTotal;
         valida = outra.valida;
     }
@@ -57,42 +56,64 @@ const std::vector<int>& Solucao::getVetorPais() const {
     return pai;
 }
 
-// Identifica as subárvores usando BFS a partir dos filhos da raiz
-void Solucao::identificarSubarvores() {
+// Identifica as subárvores subindo pelos pais, com cada vértice resolvido uma vez
+bool Solucao::identificarSubarvores() {
     int n = grafo->getNumVertices();
     int raiz = grafo->getRaiz();
     
-    // Resetar subárvores
-    std::fill(subarvore.begin(), subarvore.end(), -1);
+    // subarvore[v]: -2 = não visitado, -3 = no caminho atual, -1 = não alcança a raiz
+    const int NAO_VISITADO = -2;
+    const int NO_CAMINHO = -3;
+    std::fill(subarvore.begin(), subarvore.end(), NAO_VISITADO);
     subarvore[raiz] = 0;  // Raiz pertence à "subárvore 0"
+    demandaSubarvore.clear();
     
-    // Construir lista de adjacência da árvore
-    std::vector<std::vector<int>> filhos(n);
-    for (int i = 0; i < n; i++) {
-        if (i != raiz && pai[i] != -1) {
-            filhos[pai[i]].push_back(i);
+    // Cada filho direto da raiz inicia uma subárvore (IDs na ordem dos vértices)
+    for (int v = 0; v < n; v++) {
+        if (v != raiz && pai[v] == raiz) {
+            demandaSubarvore.push_back(grafo->getDemanda(v));
+            subarvore[v] = demandaSubarvore.size();
         }
     }
     
-    // Cada filho direto da raiz inicia uma subárvore
-    int idSubarvore = 1;
-    for (int filho : filhos[raiz]) {
-        // BFS para marcar todos os vértices da subárvore
-        std::queue<int> fila;
-        fila.push(filho);
-        subarvore[filho] = idSubarvore;
+    bool arvore = true;
+    std::vector<int> caminho;
+    for (int inicio = 0; inicio < n; inicio++) {
+        if (subarvore[inicio] != NAO_VISITADO) continue;
+        
+        // Subir até um vértice resolvido (filho da raiz ou já visitado), um vértice
+        // sem pai ou um ciclo
+        caminho.clear();
+        int v = inicio;
+        int id = -1;
+        while (true) {
+            caminho.push_back(v);
+            subarvore[v] = NO_CAMINHO;
+            int p = pai[v];
+            if (p < 0 || p >= n) {
+                arvore = arvore && p == -1;  // Sem pai: desconectado; fora do intervalo: inválido
+                break;
+            }
+            if (subarvore[p] == NO_CAMINHO) {
+                arvore = false;  // Ciclo
+                break;
+            }
+            if (subarvore[p] != NAO_VISITADO) {
+                id = subarvore[p];
+                break;
+            }
+            v = p;
+        }
         
-        while (!fila.empty()) {
-            int atual = fila.front();
-            fila.pop();
-            
-            for (int f : filhos[atual]) {
-                subarvore[f] = idSubarvore;
-                fila.push(f);
+        for (int u : caminho) {
+            subarvore[u] = id;
+            if (id > 0) {
+                demandaSubarvore[id - 1] += grafo->getDemanda(u);
             }
         }
-        idSubarvore++;
     }
+    
+    return arvore;
 }
 
 // Calcula o custo total da solução
@@ -115,24 +136,32 @@ double Solucao::getCustoTotal() const {
     return custoTotal;
 }
 
-// Verifica se a solução é viável
+// Verifica árvore, alcance da raiz e capacidade; recalcula o custo
 bool Solucao::verificarViabilidade() {
-    identificarSubarvores();
+    bool arvore = identificarSubarvores();
     
+    int n = grafo->getNumVertices();
+    int raiz = grafo->getRaiz();
     int capacidade = grafo->getCapacidade();
-    int numSub = getNumSubarvores();
     
-    // Verificar demanda de cada subárvore
-    for (int s = 1; s <= numSub; s++) {
-        int demanda = getDemandaSubarvore(s);
+    valida = arvore;
+    custoTotal = 0;
+    for (int i = 0; i < n; i++) {
+        if (i == raiz) continue;
+        if (subarvore[i] <= 0) {
+            valida = false;  // Não alcança a raiz
+        }
+        if (pai[i] >= 0 && pai[i] < n) {
+            custoTotal += grafo->getCusto(i, pai[i]);
+        }
+    }
+    for (int demanda : demandaSubarvore) {
         if (demanda > capacidade) {
             valida = false;
-            return false;
         }
     }
     
-    valida = true;
-    return true;
+    return valida;
 }
 
 // Retorna se a solução é válida
@@ -140,29 +169,17 @@ bool Solucao::isValida() const {
     return valida;
 }
 
-// Calcula a demanda de uma subárvore
+// Demanda de uma subárvore
 int Solucao::getDemandaSubarvore(int idSubarvore) const {
-    int demanda = 0;
-    int n = grafo->getNumVertices();
-    
-    for (int i = 0; i < n; i++) {
-        if (subarvore[i] == idSubarvore) {
-            demanda += grafo->getDemanda(i);
-        }
+    if (idSubarvore < 1 || idSubarvore > (int)demandaSubarvore.size()) {
+        return 0;
     }
-    
-    return demanda;
+    return demandaSubarvore[idSubarvore - 1];
 }
 
 // Retorna o número de subárvores
 int Solucao::getNumSubarvores() const {
-    std::set<int> subs;
-    for (int s : subarvore) {
-        if (s > 0) {  // Ignorar raiz (0) e não conectados (-1)
-            subs.insert(s);
-        }
-    }
-    return subs.size();
+    return demandaSubarvore.size();
 }
 
 // Retorna a subárvore de um vértice
@@ -200,7 +217,7 @@ std::string Solucao::toStringCSAcademy() const {
     
     for (int i = 0; i < n; i++) {
         if (i != raiz && pai[i] != -1) {
-            ss << pai[i] << " " << i << "\n";
+            ss << grafo->getIdOriginal(pai[i]) << " " << grafo->getIdOriginal(i) << "\n";
         }
     }
     
@@ -222,7 +239,7 @@ void Solucao::imprimir() const {
         if (!vertices.empty()) {
             std::cout << "  Subárvore " << s << ": {";
             for (size_t i = 0; i < vertices.size(); i++) {
-                std::cout << vertices[i];
+                std::cout << grafo->getIdOriginal(vertices[i]);
                 if (i < vertices.size() - 1) std::cout << ", ";
             }
             std::cout << "} - Demanda: " << getDemandaSubarvore(s) << std::endl;
@@ -238,6 +255,7 @@ void Solucao::limpar() {
     int raiz = grafo->getRaiz();
     std::fill(pai.begin(), pai.end(), -1);
     std::fill(subarvore.begin(), subarvore.end(), -1);
+    demandaSubarvore.clear();
     pai[raiz] = -1;
     subarvore[raiz] = 0;
     custoTotal = 0;
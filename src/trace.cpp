@@ -0,0 +1,145 @@
+#include "../includes/trace.h"
+#include "../includes/utils.h"
+#include <cstring>
+#include <cmath>
+#include <vector>
+
+// Cabeçalho do arquivo de trace
+namespace {
+    const char ASSINATURA_TRACE[8] = {'C', 'M', 'S', 'T', 'T', 'R', 'C', '1'};
+    const uint32_t VERSAO_TRACE = 1;
+    const size_t LOTE_ESCRITA = 4096;  // Eventos por fwrite
+    const int PAUSA_ESCRITOR_MS = 2;   // Espera da thread de escrita com a fila vazia
+
+    struct CabecalhoTrace {
+        char assinatura[8];
+        uint32_t versao;
+        uint32_t tamanhoEvento;
+        uint64_t numEventos;
+        uint64_t descartados;
+    };
+
+    static_assert(sizeof(CabecalhoTrace) == 32, "CabecalhoTrace deve ter 32 bytes");
+
+    CabecalhoTrace montarCabecalho(uint64_t numEventos, uint64_t descartados) {
+        CabecalhoTrace c;
+        std::memcpy(c.assinatura, ASSINATURA_TRACE, sizeof(c.assinatura));
+        c.versao = VERSAO_TRACE;
+        c.tamanhoEvento = sizeof(EventoTrace);
+        c.numEventos = numEventos;
+        c.descartados = descartados;
+        return c;
+    }
+}
+
+RegistroTrace::RegistroTrace(size_t capacidade)
+    : fila(capacidade), arquivo(nullptr), encerrando(false), descartados(0), gravados(0),
+      inicio(std::chrono::steady_clock::now()) {}
+
+RegistroTrace::~RegistroTrace() {
+    fechar();
+}
+
+// Cria o arquivo e inicia a thread de escrita
+bool RegistroTrace::abrir(const std::string& nomeArquivo) {
+    fechar();
+    arquivo = std::fopen(nomeArquivo.c_str(), "wb");
+    if (arquivo == nullptr) {
+        return false;
+    }
+    CabecalhoTrace cabecalho = montarCabecalho(0, 0);
+    std::fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo);
+
+    encerrando.store(false);
+    descartados.store(0);
+    gravados = 0;
+    inicio = std::chrono::steady_clock::now();
+    escritor = std::thread(&RegistroTrace::laco, this);
+    return true;
+}
+
+// Esvazia a fila em lotes; após o pedido de encerramento, grava o que restou
+void RegistroTrace::laco() {
+    std::vector<EventoTrace> lote(LOTE_ESCRITA);
+    while (true) {
+        bool fim = encerrando.load(std::memory_order_acquire);
+        size_t k = 0;
+        while (k < LOTE_ESCRITA && fila.receber(lote[k])) {
+            k++;
+        }
+        if (k > 0) {
+            gravados += std::fwrite(lote.data(), sizeof(EventoTrace), k, arquivo);
+        }
+        if (k == LOTE_ESCRITA) {
+            continue;
+        }
+        if (fim) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(PAUSA_ESCRITOR_MS));
+    }
+}
+
+// Junta a thread de escrita e completa o cabeçalho
+void RegistroTrace::fechar() {
+    if (arquivo == nullptr) {
+        return;
+    }
+    encerrando.store(true, std::memory_order_release);
+    escritor.join();
+
+    CabecalhoTrace cabecalho = montarCabecalho(gravados, descartados.load());
+    std::fseek(arquivo, 0, SEEK_SET);
+    std::fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo);
+    std::fclose(arquivo);
+    arquivo = nullptr;
+}
+
+uint64_t RegistroTrace::getDescartados() const {
+    return descartados.load();
+}
+
+// Converte o trace binário em CSV
+long RegistroTrace::converterCSV(const std::string& nomeArquivo, std::ostream& saida, std::string& erro) {
+    FILE* f = std::fopen(nomeArquivo.c_str(), "rb");
+    if (f == nullptr) {
+        erro = "Não foi possível abrir o trace: " + nomeArquivo;
+        return -1;
+    }
+
+    CabecalhoTrace cabecalho;
+    if (std::fread(&cabecalho, sizeof(cabecalho), 1, f) != 1 ||
+        std::memcmp(cabecalho.assinatura, ASSINATURA_TRACE, sizeof(ASSINATURA_TRACE)) != 0) {
+        std::fclose(f);
+        erro = "Arquivo não é um trace do cmst: " + nomeArquivo;
+        return -1;
+    }
+    if (cabecalho.versao != VERSAO_TRACE || cabecalho.tamanhoEvento != sizeof(EventoTrace)) {
+        std::fclose(f);
+        erro = "Versão de trace não suportada: " + std::to_string(cabecalho.versao);
+        return -1;
+    }
+
+    saida << "instante_s,iteracao,alpha_idx,custo,viavel,abandonada,incumbente\n";
+    long numEventos = 0;
+    EventoTrace e;
+    while (std::fread(&e, sizeof(e), 1, f) == 1) {
+        saida << Utils::formatarDouble(e.instante * 1e-9, 9) << ","
+              << e.iteracao << ","
+              << e.alphaIdx << ","
+              << Utils::formatarDouble(e.custo, 2) << ","
+              << (int)e.viavel << ","
+              << (int)e.abandonada << ",";
+        if (std::isfinite(e.incumbente)) {
+            saida << Utils::formatarDouble(e.incumbente, 2);
+        }
+        saida << "\n";
+        numEventos++;
+    }
+    std::fclose(f);
+
+    if (cabecalho.descartados > 0) {
+        erro = "Aviso: " + std::to_string(cabecalho.descartados) + " eventos descartados por fila cheia";
+    }
+    return numEventos;
+}
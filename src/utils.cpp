@@ -4,19 +4,30 @@
 #include <ctime>
 #include <iostream>
 #include <climits>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
 
 // ==================== Randomizador ====================
 
 // Variáveis estáticas
-std::mt19937 Randomizador::gerador;
-unsigned int Randomizador::sementeAtual = 0;
-bool Randomizador::inicializado = false;
+thread_local std::mt19937 Randomizador::gerador;
+thread_local unsigned int Randomizador::sementeAtual = 0;
+thread_local bool Randomizador::inicializado = false;
 
 unsigned int Randomizador::inicializar() {
     auto agora = std::chrono::high_resolution_clock::now();
     auto duracao = agora.time_since_epoch();
+    // O identificador da thread separa sementes geradas no mesmo instante
     sementeAtual = static_cast<unsigned int>(
-        std::chrono::duration_cast<std::chrono::nanoseconds>(duracao).count() % UINT_MAX
+        (std::chrono::duration_cast<std::chrono::nanoseconds>(duracao).count() ^
+         std::hash<std::thread::id>()(std::this_thread::get_id())) % UINT_MAX
     );
     gerador.seed(sementeAtual);
     inicializado = true;
@@ -67,6 +78,25 @@ std::mt19937& Randomizador::getGerador() {
     return gerador;
 }
 
+void Randomizador::salvarEstado(std::ostream& out) {
+    if (!inicializado) {
+        inicializar();
+    }
+    out << sementeAtual << " " << gerador;
+}
+
+bool Randomizador::carregarEstado(std::istream& in) {
+    unsigned int semente = 0;
+    std::mt19937 lido;
+    if (!(in >> semente >> lido)) {
+        return false;
+    }
+    sementeAtual = semente;
+    gerador = lido;
+    inicializado = true;
+    return true;
+}
+
 // ==================== Cronômetro ====================
 
 Cronometro::Cronometro() : rodando(false) {}
@@ -93,97 +123,239 @@ double Cronometro::getTempoMilissegundos() const {
     return duracao.count() / 1000.0;
 }
 
+// ==================== ControleExecucao ====================
+
+ControleExecucao::ControleExecucao() : cancelado(false), intervalo(1) {}
+
+void ControleExecucao::cancelar() {
+    cancelado.store(true, std::memory_order_relaxed);
+}
+
+bool ControleExecucao::isCancelado() const {
+    return cancelado.load(std::memory_order_relaxed);
+}
+
+void ControleExecucao::setCallbackProgresso(std::function<void(const ProgressoExecucao&)> funcao,
+                                            int intervaloIteracoes) {
+    callback = funcao;
+    intervalo = std::max(1, intervaloIteracoes);
+}
+
+void ControleExecucao::reportar(int iteracao, int totalIteracoes, double melhorCusto,
+                                double tempoSegundos) const {
+    if (!callback || (iteracao % intervalo != 0 && iteracao != totalIteracoes)) {
+        return;
+    }
+    ProgressoExecucao progresso;
+    progresso.iteracao = iteracao;
+    progresso.totalIteracoes = totalIteracoes;
+    progresso.melhorCusto = melhorCusto;
+    progresso.tempoSegundos = tempoSegundos;
+    callback(progresso);
+}
+
 // ==================== ResultadoExecucao ====================
 
 ResultadoExecucao::ResultadoExecucao()
-    : numVertices(0), capacidade(0), alpha(-1), iteracoes(-1),
+    : numVertices(0), capacidade(0), construtor("prim"), alpha(-1), iteracoes(-1),
       tamanhoBloco(-1), semente(0), tempoSegundos(0),
-      melhorSolucao(0), mediaSolucoes(-1), melhorAlpha(-1), solucaoOtima(-1) {}
+      melhorSolucao(0), mediaSolucoes(-1), melhorAlpha(-1), taxaAbandono(-1),
+      tamanhoPool(-1), recombinacoes(0), melhoriasRecombinacao(0), tempoRecombinacao(0), solucaoOtima(-1) {}
 
-// ==================== EscritorCSV ====================
+// ==================== EscritorBufferizado ====================
+
+EscritorBufferizado::EscritorBufferizado(const std::string& arquivo, const std::string& cabecalho, bool lock)
+    : nomeArquivo(arquivo), textoCabecalho(cabecalho), linhasPendentes(0), usarLock(lock) {}
 
-EscritorCSV::EscritorCSV(const std::string& arquivo) : nomeArquivo(arquivo) {}
+EscritorBufferizado::~EscritorBufferizado() {
+    descarregar();
+}
+
+std::string EscritorBufferizado::getNomeArquivo() const {
+    return nomeArquivo;
+}
 
-bool EscritorCSV::arquivoExiste() const {
-    std::ifstream f(nomeArquivo);
-    return f.good();
+void EscritorBufferizado::anexarLinha(const std::string& linha) {
+    buffer += linha;
+    linhasPendentes++;
+    if (linhasPendentes >= TAMANHO_LOTE) {
+        descarregar();
+    }
 }
 
-void EscritorCSV::escreverCabecalho() {
-    if (arquivoExiste()) {
-        return;  // Arquivo já existe, não sobrescrever cabeçalho
+bool EscritorBufferizado::descarregar() {
+    if (buffer.empty()) {
+        return true;
     }
     
-    std::ofstream arquivo(nomeArquivo);
-    if (!arquivo.is_open()) {
-        std::cerr << "Erro ao criar arquivo CSV: " << nomeArquivo << std::endl;
-        return;
+    int fd = open(nomeArquivo.c_str(), O_RDWR | O_APPEND | O_CREAT, 0644);  // Leitura para conferir o cabeçalho
+    if (fd < 0) {
+        std::cerr << "Erro ao abrir arquivo de resultados: " << nomeArquivo << std::endl;
+        return false;
+    }
+    
+    if (usarLock && flock(fd, LOCK_EX) != 0) {
+        std::cerr << "Aviso: não foi possível obter lock em " << nomeArquivo << std::endl;
     }
     
-    arquivo << "data_hora,instancia,n_vertices,capacidade,algoritmo,alpha,iteracoes,"
-            << "tamanho_bloco,semente,tempo_segundos,melhor_solucao,media_solucoes,"
-            << "melhor_alpha,solucao_otima" << std::endl;
+    // Cabeçalho apenas em arquivo vazio, na mesma escrita das linhas; num
+    // arquivo existente, o cabeçalho precisa ser o atual (colunas de outra
+    // versão ficariam desalinhadas, e as linhas seriam descartadas na leitura)
+    std::string dados;
+    struct stat info;
+    bool ok = true;
+    if (!textoCabecalho.empty() && fstat(fd, &info) == 0 && info.st_size == 0) {
+        dados = textoCabecalho + buffer;
+    } else if (!textoCabecalho.empty()) {
+        std::string existente(textoCabecalho.size(), '\0');
+        ssize_t lido = pread(fd, &existente[0], existente.size(), 0);
+        if (lido != (ssize_t)existente.size() || existente != textoCabecalho) {
+            std::cerr << "Erro: o cabeçalho de " << nomeArquivo << " não é o do formato atual "
+                      << "(arquivo de versão anterior?); renomeie-o ou use outro arquivo. "
+                      << linhasPendentes << " linha(s) não gravada(s)" << std::endl;
+            ok = false;
+        } else {
+            dados.swap(buffer);
+        }
+    } else {
+        dados.swap(buffer);
+    }
     
-    arquivo.close();
+    // Uma única chamada write() em O_APPEND não intercala com outros processos;
+    // o laço só repete em escritas parciais (disco cheio, sinais)
+    size_t escrito = 0;
+    while (escrito < dados.size()) {
+        ssize_t r = write(fd, dados.data() + escrito, dados.size() - escrito);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Erro ao gravar em " << nomeArquivo << ": " << strerror(errno) << std::endl;
+            ok = false;
+            break;
+        }
+        escrito += r;
+    }
+    
+    if (usarLock) {
+        flock(fd, LOCK_UN);
+    }
+    close(fd);
+    
+    buffer.clear();
+    linhasPendentes = 0;
+    return ok;
 }
 
+// ==================== EscritorCSV ====================
+
+EscritorCSV::EscritorCSV(const std::string& arquivo, bool lock)
+    : EscritorBufferizado(arquivo,
+                          "data_hora,instancia,n_vertices,capacidade,algoritmo,alpha,iteracoes,"
+                          "tamanho_bloco,semente,tempo_segundos,melhor_solucao,media_solucoes,"
+                          "melhor_alpha,solucao_otima,construtor,politica_alpha,opcoes\n",
+                          lock) {}
+
 void EscritorCSV::escreverResultado(const ResultadoExecucao& r) {
-    // Garantir que o cabeçalho existe
-    escreverCabecalho();
-    
-    std::ofstream arquivo(nomeArquivo, std::ios::app);
-    if (!arquivo.is_open()) {
-        std::cerr << "Erro ao abrir arquivo CSV: " << nomeArquivo << std::endl;
-        return;
-    }
+    std::stringstream linha;
     
-    arquivo << r.dataHora << ","
-            << r.instancia << ","
-            << r.numVertices << ","
-            << r.capacidade << ","
-            << r.algoritmo << ",";
+    linha << r.dataHora << ","
+          << r.instancia << ","
+          << r.numVertices << ","
+          << r.capacidade << ","
+          << r.algoritmo << ",";
     
     // Alpha (pode ser vazio)
     if (r.alpha >= 0) {
-        arquivo << Utils::formatarDouble(r.alpha, 2);
+        linha << Utils::formatarDouble(r.alpha, 2);
     }
-    arquivo << ",";
+    linha << ",";
     
     // Iterações (pode ser vazio)
     if (r.iteracoes >= 0) {
-        arquivo << r.iteracoes;
+        linha << r.iteracoes;
     }
-    arquivo << ",";
+    linha << ",";
     
     // Tamanho do bloco (pode ser vazio)
     if (r.tamanhoBloco >= 0) {
-        arquivo << r.tamanhoBloco;
+        linha << r.tamanhoBloco;
     }
-    arquivo << ",";
+    linha << ",";
     
-    arquivo << r.semente << ","
-            << Utils::formatarDouble(r.tempoSegundos, 6) << ","
-            << Utils::formatarDouble(r.melhorSolucao, 2) << ",";
+    linha << r.semente << ","
+          << Utils::formatarDouble(r.tempoSegundos, 6) << ","
+          << Utils::formatarDouble(r.melhorSolucao, 2) << ",";
     
     // Média das soluções (pode ser vazio)
     if (r.mediaSolucoes >= 0) {
-        arquivo << Utils::formatarDouble(r.mediaSolucoes, 2);
+        linha << Utils::formatarDouble(r.mediaSolucoes, 2);
     }
-    arquivo << ",";
+    linha << ",";
     
     // Melhor alpha (pode ser vazio)
     if (r.melhorAlpha >= 0) {
-        arquivo << Utils::formatarDouble(r.melhorAlpha, 2);
+        linha << Utils::formatarDouble(r.melhorAlpha, 2);
     }
-    arquivo << ",";
+    linha << ",";
     
     // Solução ótima (pode ser vazio)
     if (r.solucaoOtima >= 0) {
-        arquivo << Utils::formatarDouble(r.solucaoOtima, 2);
+        linha << Utils::formatarDouble(r.solucaoOtima, 2);
     }
     
-    arquivo << std::endl;
-    arquivo.close();
+    // Configuração sem coluna numérica (distingue as execuções no cmst compare)
+    linha << "," << r.construtor << "," << r.politicaAlpha << "," << r.opcoes;
+    
+    linha << "\n";
+    anexarLinha(linha.str());
+}
+
+// ==================== EscritorJSONL ====================
+
+EscritorJSONL::EscritorJSONL(const std::string& arquivo, bool lock) : EscritorBufferizado(arquivo, "", lock) {}
+
+void EscritorJSONL::escreverResultado(const ResultadoExecucao& r, const std::vector<int>& pais) {
+    // Campos não aplicáveis (-1) ou infinitos viram null
+    auto numero = [](double valor, int precisao) {
+        return (valor >= 0 && std::isfinite(valor)) ? Utils::formatarDouble(valor, precisao) : std::string("null");
+    };
+    
+    std::stringstream linha;
+    linha << "{\"data_hora\":\"" << Utils::escaparJSON(r.dataHora) << "\""
+          << ",\"instancia\":\"" << Utils::escaparJSON(r.instancia) << "\""
+          << ",\"n_vertices\":" << r.numVertices
+          << ",\"capacidade\":" << r.capacidade
+          << ",\"algoritmo\":\"" << Utils::escaparJSON(r.algoritmo) << "\""
+          << ",\"construtor\":\"" << Utils::escaparJSON(r.construtor) << "\""
+          << ",\"alpha\":" << numero(r.alpha, 4)
+          << ",\"iteracoes\":" << (r.iteracoes >= 0 ? std::to_string(r.iteracoes) : "null")
+          << ",\"tamanho_bloco\":" << (r.tamanhoBloco >= 0 ? std::to_string(r.tamanhoBloco) : "null")
+          << ",\"semente\":" << r.semente
+          << ",\"tempo_segundos\":" << Utils::formatarDouble(r.tempoSegundos, 6)
+          << ",\"melhor_solucao\":" << numero(r.melhorSolucao, 2)
+          << ",\"media_solucoes\":" << numero(r.mediaSolucoes, 2)
+          << ",\"melhor_alpha\":" << numero(r.melhorAlpha, 4)
+          << ",\"taxa_abandono\":" << numero(r.taxaAbandono, 4)
+          << ",\"tamanho_pool\":" << (r.tamanhoPool >= 0 ? std::to_string(r.tamanhoPool) : "null")
+          << ",\"recombinacoes\":" << (r.tamanhoPool >= 0 ? std::to_string(r.recombinacoes) : "null")
+          << ",\"melhorias_recombinacao\":" << (r.tamanhoPool >= 0 ? std::to_string(r.melhoriasRecombinacao) : "null")
+          << ",\"tempo_recombinacao\":" << (r.tamanhoPool >= 0 ? Utils::formatarDouble(r.tempoRecombinacao, 6) : "null")
+          << ",\"solucao_otima\":" << numero(r.solucaoOtima, 2)
+          << ",\"politica_alpha\":\"" << Utils::escaparJSON(r.politicaAlpha) << "\""
+          << ",\"opcoes\":\"" << Utils::escaparJSON(r.opcoes) << "\"";
+    
+    if (r.solucaoOtima > 0 && r.melhorSolucao >= 0 && std::isfinite(r.melhorSolucao)) {
+        double desvio = (r.melhorSolucao - r.solucaoOtima) / r.solucaoOtima * 100;
+        linha << ",\"desvio_percentual\":" << Utils::formatarDouble(desvio, 4);
+    }
+    
+    linha << ",\"pais\":[";
+    for (size_t i = 0; i < pais.size(); i++) {
+        if (i > 0) linha << ",";
+        linha << pais[i];
+    }
+    linha << "]}\n";
+    
+    anexarLinha(linha.str());
 }
 
 // ==================== Utils ====================
@@ -203,3 +375,56 @@ std::string Utils::formatarDouble(double valor, int precisao) {
     ss << std::fixed << std::setprecision(precisao) << valor;
     return ss.str();
 }
+
+std::string Utils::escaparJSON(const std::string& texto) {
+    std::string saida;
+    saida.reserve(texto.size());
+    for (char c : texto) {
+        switch (c) {
+            case '"':  saida += "\\\""; break;
+            case '\\': saida += "\\\\"; break;
+            case '\n': saida += "\\n"; break;
+            case '\r': saida += "\\r"; break;
+            case '\t': saida += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char tmp[8];
+                    snprintf(tmp, sizeof(tmp), "\\u%04x", c);
+                    saida += tmp;
+                } else {
+                    saida += c;
+                }
+        }
+    }
+    return saida;
+}
+
+bool Utils::gravarArquivoAtomico(const std::string& caminho, const std::string& conteudo) {
+    std::string temporario = caminho + ".tmp." + std::to_string(getpid());
+    int fd = open(temporario.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        std::cerr << "Erro ao criar " << temporario << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+    
+    bool ok = true;
+    size_t escrito = 0;
+    while (escrito < conteudo.size()) {
+        ssize_t r = write(fd, conteudo.data() + escrito, conteudo.size() - escrito);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        escrito += r;
+    }
+    ok = ok && fsync(fd) == 0;
+    close(fd);
+    
+    if (!ok || rename(temporario.c_str(), caminho.c_str()) != 0) {
+        std::cerr << "Erro ao gravar " << caminho << ": " << strerror(errno) << std::endl;
+        unlink(temporario.c_str());
+        return false;
+    }
+    return true;
+}